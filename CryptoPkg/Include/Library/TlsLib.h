@@ -419,6 +419,28 @@ TlsSetSessionId (
   IN     UINT16                   SessionIdLen
   );
 
+/**
+  Sets a previously established TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function offers the session returned by TlsGetSession() for resumption
+  on the next handshake of the specified TLS connection. If the server does not
+  accept it, a full handshake is performed.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Session         Pointer to the session object returned by TlsGetSession().
+
+  @retval  EFI_SUCCESS           Session was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The session can not be used by this connection.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetSession (
+  IN     VOID                     *Tls,
+  IN     VOID                     *Session
+  );
+
 /**
   Adds the CA to the cert store when requesting Server or Client authentication.
 
@@ -632,6 +654,36 @@ TlsGetSessionId (
   IN OUT UINT16                   *SessionIdLen
   );
 
+/**
+  Gets the TLS/SSL session established on the specified TLS connection.
+
+  This function returns a reference to the session negotiated by the completed
+  handshake, which can later be passed to TlsSetSession() to resume it. The
+  caller must release it with TlsFreeSession().
+
+  @param[in]  Tls             Pointer to the TLS object.
+
+  @return  Pointer to the session object, or NULL if there is no established session.
+
+**/
+VOID *
+EFIAPI
+TlsGetSession (
+  IN     VOID                     *Tls
+  );
+
+/**
+  Release a TLS/SSL session object returned by TlsGetSession().
+
+  @param[in]  Session         Pointer to the session object to be released.
+
+**/
+VOID
+EFIAPI
+TlsFreeSession (
+  IN     VOID                     *Session
+  );
+
 /**
   Gets the client random data used in the specified TLS connection.
 
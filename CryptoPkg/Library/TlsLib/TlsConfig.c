@@ -395,6 +395,43 @@ TlsSetSessionId (
   return EFI_SUCCESS;
 }
 
+/**
+  Sets a previously established TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function offers the session returned by TlsGetSession() for resumption
+  on the next handshake of the specified TLS connection. If the server does not
+  accept it, a full handshake is performed.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Session         Pointer to the session object returned by TlsGetSession().
+
+  @retval  EFI_SUCCESS           Session was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The session can not be used by this connection.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetSession (
+  IN     VOID                     *Tls,
+  IN     VOID                     *Session
+  )
+{
+  TLS_CONNECTION  *TlsConn;
+
+  TlsConn = (TLS_CONNECTION *) Tls;
+
+  if (TlsConn == NULL || TlsConn->Ssl == NULL || Session == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (SSL_set_session (TlsConn->Ssl, (SSL_SESSION *) Session) != 1) {
+    return EFI_UNSUPPORTED;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Adds the CA to the cert store when requesting Server or Client authentication.
 
@@ -826,6 +863,55 @@ TlsGetSessionId (
   return EFI_SUCCESS;
 }
 
+/**
+  Gets the TLS/SSL session established on the specified TLS connection.
+
+  This function returns a reference to the session negotiated by the completed
+  handshake, which can later be passed to TlsSetSession() to resume it. The
+  caller must release it with TlsFreeSession().
+
+  @param[in]  Tls             Pointer to the TLS object.
+
+  @return  Pointer to the session object, or NULL if there is no established session.
+
+**/
+VOID *
+EFIAPI
+TlsGetSession (
+  IN     VOID                     *Tls
+  )
+{
+  TLS_CONNECTION  *TlsConn;
+
+  TlsConn = (TLS_CONNECTION *) Tls;
+
+  if (TlsConn == NULL || TlsConn->Ssl == NULL) {
+    return NULL;
+  }
+
+  //
+  // SSL_get1_session() takes a reference, so the session outlives this connection.
+  //
+  return (VOID *) SSL_get1_session (TlsConn->Ssl);
+}
+
+/**
+  Release a TLS/SSL session object returned by TlsGetSession().
+
+  @param[in]  Session         Pointer to the session object to be released.
+
+**/
+VOID
+EFIAPI
+TlsFreeSession (
+  IN     VOID                     *Session
+  )
+{
+  if (Session != NULL) {
+    SSL_SESSION_free ((SSL_SESSION *) Session);
+  }
+}
+
 /**
   Gets the client random data used in the specified TLS connection.
 
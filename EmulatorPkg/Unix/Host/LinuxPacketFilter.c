@@ -2,8 +2,9 @@
  Linux Packet Filter implementation of the EMU_SNP_PROTOCOL that allows the
  emulator to get on real networks.
 
- Currently only the Berkeley Packet Filter is fully implemented and this file
- is just a template that needs to get filled in.
+ The emulator is attached to a TAP interface (PcdEmuNetworkInterface names it,
+ for example tap0) through /dev/net/tun.  The interface can be bridged or
+ routed on the host like any other link.
 
 Copyright (c) 2004 - 2009, Intel Corporation. All rights reserved.<BR>
 Portitions copyright (c) 2011, Apple Inc. All rights reserved.
@@ -23,6 +24,17 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #ifndef __APPLE__
 
+#include <linux/if_tun.h>
+
+#include <Library/NetLib.h>
+
+//
+// A TAP read returns at most one frame, so the read buffer only has to hold
+// the largest frame the interface can deliver.
+//
+#define EMU_SNP_TAP_DEVICE            "/dev/net/tun"
+#define EMU_SNP_TAP_READ_BUFFER_SIZE  0x10000
+
 #define EMU_SNP_PRIVATE_SIGNATURE SIGNATURE_32('E', 'M', 's', 'n')
 typedef struct {
   UINTN                       Signature;
@@ -33,11 +45,155 @@ typedef struct {
   EMU_SNP_PROTOCOL            EmuSnp;
   EFI_SIMPLE_NETWORK_MODE     *Mode;
 
+  int                         TapFd;
+  char                        *InterfaceName;
+  EFI_MAC_ADDRESS             MacAddress;
+  UINTN                       ReadBufferSize;
+  VOID                        *ReadBuffer;
+
+  //
+  // Length of a frame that has been read from the TAP device but not yet
+  // returned, because the caller's buffer was too small.
+  //
+  UINTN                       PendingLength;
+
+  EFI_NETWORK_STATISTICS      Statistics;
 } EMU_SNP_PRIVATE;
 
 #define EMU_SNP_PRIVATE_DATA_FROM_THIS(a) \
          CR(a, EMU_SNP_PRIVATE, EmuSnp, EMU_SNP_PRIVATE_SIGNATURE)
 
+
+//
+// Strange, but there doesn't appear to be any structure for the Ethernet header in edk2...
+//
+
+typedef struct {
+  UINT8   DstAddr[NET_ETHER_ADDR_LEN];
+  UINT8   SrcAddr[NET_ETHER_ADDR_LEN];
+  UINT16  Type;
+} ETHERNET_HEADER;
+
+
+/**
+  Reset the statistics counters.  Counters that the TAP backend does not
+  maintain are reported as all ones, which the UEFI specification defines
+  as "not supported".
+
+  @param  Private  The SNP instance.
+
+**/
+VOID
+EmuSnpResetStatistics (
+  IN EMU_SNP_PRIVATE  *Private
+  )
+{
+  EFI_NETWORK_STATISTICS  *Stats;
+
+  Stats = &Private->Statistics;
+  SetMem (Stats, sizeof (EFI_NETWORK_STATISTICS), 0xFF);
+
+  Stats->RxTotalFrames     = 0;
+  Stats->RxGoodFrames      = 0;
+  Stats->RxUndersizeFrames = 0;
+  Stats->RxDroppedFrames   = 0;
+  Stats->RxUnicastFrames   = 0;
+  Stats->RxBroadcastFrames = 0;
+  Stats->RxMulticastFrames = 0;
+  Stats->RxTotalBytes      = 0;
+  Stats->TxTotalFrames     = 0;
+  Stats->TxGoodFrames      = 0;
+  Stats->TxDroppedFrames   = 0;
+  Stats->TxUnicastFrames   = 0;
+  Stats->TxBroadcastFrames = 0;
+  Stats->TxMulticastFrames = 0;
+  Stats->TxTotalBytes      = 0;
+}
+
+
+/**
+  Classify a destination MAC address and count the frame.
+
+  @param  Mode        The SNP mode.
+  @param  DstAddr     The destination MAC address of the frame.
+  @param  Unicast     Counter to bump for unicast frames.
+  @param  Broadcast   Counter to bump for broadcast frames.
+  @param  Multicast   Counter to bump for multicast frames.
+
+**/
+VOID
+EmuSnpCountFrame (
+  IN     EFI_SIMPLE_NETWORK_MODE  *Mode,
+  IN     UINT8                    *DstAddr,
+  IN OUT UINT64                   *Unicast,
+  IN OUT UINT64                   *Broadcast,
+  IN OUT UINT64                   *Multicast
+  )
+{
+  if (CompareMem (DstAddr, &Mode->BroadcastAddress, NET_ETHER_ADDR_LEN) == 0) {
+    (*Broadcast)++;
+  } else if ((DstAddr[0] & 0x01) != 0) {
+    (*Multicast)++;
+  } else {
+    (*Unicast)++;
+  }
+}
+
+
+/**
+  Apply the receive filter settings to a frame read from the TAP device.
+  The TAP interface hands us every frame on the host side of the link, so
+  the filtering that a NIC would do in hardware is done here.
+
+  @param  Private     The SNP instance.
+  @param  EnetHeader  The Ethernet header of the received frame.
+
+  @retval TRUE   The frame should be passed up the stack.
+  @retval FALSE  The frame should be dropped.
+
+**/
+BOOLEAN
+EmuSnpAcceptFrame (
+  IN EMU_SNP_PRIVATE  *Private,
+  IN ETHERNET_HEADER  *EnetHeader
+  )
+{
+  EFI_SIMPLE_NETWORK_MODE  *Mode;
+  UINT32                   Setting;
+  UINTN                    Index;
+
+  Mode    = Private->Mode;
+  Setting = Mode->ReceiveFilterSetting;
+
+  if ((Setting & EFI_SIMPLE_NETWORK_RECEIVE_PROMISCUOUS) != 0) {
+    return TRUE;
+  }
+
+  if (CompareMem (EnetHeader->DstAddr, &Mode->CurrentAddress, NET_ETHER_ADDR_LEN) == 0) {
+    return (BOOLEAN) ((Setting & EFI_SIMPLE_NETWORK_RECEIVE_UNICAST) != 0);
+  }
+
+  if (CompareMem (EnetHeader->DstAddr, &Mode->BroadcastAddress, NET_ETHER_ADDR_LEN) == 0) {
+    return (BOOLEAN) ((Setting & EFI_SIMPLE_NETWORK_RECEIVE_BROADCAST) != 0);
+  }
+
+  if ((EnetHeader->DstAddr[0] & 0x01) != 0) {
+    if ((Setting & EFI_SIMPLE_NETWORK_RECEIVE_PROMISCUOUS_MULTICAST) != 0) {
+      return TRUE;
+    }
+
+    if ((Setting & EFI_SIMPLE_NETWORK_RECEIVE_MULTICAST) != 0) {
+      for (Index = 0; Index < Mode->MCastFilterCount; Index++) {
+        if (CompareMem (EnetHeader->DstAddr, &Mode->MCastFilter[Index], NET_ETHER_ADDR_LEN) == 0) {
+          return TRUE;
+        }
+      }
+    }
+  }
+
+  return FALSE;
+}
+
 /**
   Register storage for SNP Mode.
 
@@ -60,6 +216,29 @@ EmuSnpCreateMapping (
 
   Private->Mode = Mode;
 
+  //
+  // Set the broadcast address.
+  //
+  SetMem (&Mode->BroadcastAddress, sizeof (EFI_MAC_ADDRESS), 0xFF);
+
+  CopyMem (&Mode->CurrentAddress, &Private->MacAddress, sizeof (EFI_MAC_ADDRESS));
+  CopyMem (&Mode->PermanentAddress, &Private->MacAddress, sizeof (EFI_MAC_ADDRESS));
+
+  //
+  // The host side of the TAP interface owns its MAC address, so the emulator
+  // uses a different one by changing the last byte.
+  //
+  Mode->CurrentAddress.Addr[NET_ETHER_ADDR_LEN - 1]++;
+
+  //
+  // Receive filtering is done in software, so every filter can be offered.
+  //
+  Mode->ReceiveFilterMask = EFI_SIMPLE_NETWORK_RECEIVE_UNICAST |
+                            EFI_SIMPLE_NETWORK_RECEIVE_MULTICAST |
+                            EFI_SIMPLE_NETWORK_RECEIVE_BROADCAST |
+                            EFI_SIMPLE_NETWORK_RECEIVE_PROMISCUOUS |
+                            EFI_SIMPLE_NETWORK_RECEIVE_PROMISCUOUS_MULTICAST;
+
   return EFI_SUCCESS;
 }
 
@@ -80,11 +259,84 @@ EmuSnpStart (
   IN EMU_SNP_PROTOCOL  *This
   )
 {
+  EFI_STATUS         Status;
   EMU_SNP_PRIVATE    *Private;
+  struct ifreq       TapIf;
 
   Private = EMU_SNP_PRIVATE_DATA_FROM_THIS (This);
 
-  return EFI_UNSUPPORTED;
+  switch (Private->Mode->State) {
+    case EfiSimpleNetworkStopped:
+      break;
+
+    case EfiSimpleNetworkStarted:
+    case EfiSimpleNetworkInitialized:
+      return EFI_ALREADY_STARTED;
+      break;
+
+    default:
+      return EFI_DEVICE_ERROR;
+      break;
+  }
+
+  if (Private->InterfaceName == NULL) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  Status = EFI_SUCCESS;
+  if (Private->TapFd < 0) {
+    //
+    // Open the TUN/TAP clone device in non-blocking mode so Receive() can
+    // poll it.
+    //
+    Private->TapFd = open (EMU_SNP_TAP_DEVICE, O_RDWR | O_NONBLOCK);
+    if (Private->TapFd < 0) {
+      printf ("SNP: Unable to open %s: %s\n", EMU_SNP_TAP_DEVICE, strerror (errno));
+      goto DeviceErrorExit;
+    }
+
+    //
+    // Attach to the TAP interface.  Frames are exchanged without the packet
+    // information header, so a read or write is exactly one Ethernet frame.
+    //
+    ZeroMem (&TapIf, sizeof (TapIf));
+    TapIf.ifr_flags = IFF_TAP | IFF_NO_PI;
+    AsciiStrnCpy (TapIf.ifr_name, Private->InterfaceName, sizeof (TapIf.ifr_name) - 1);
+    if (ioctl (Private->TapFd, TUNSETIFF, &TapIf) < 0) {
+      printf (
+        "SNP: Unable to attach to '%s': %s.  Create it with 'sudo ip tuntap add dev %s mode tap user $USER'.\n",
+        Private->InterfaceName,
+        strerror (errno),
+        Private->InterfaceName
+        );
+      goto DeviceErrorExit;
+    }
+
+    //
+    // Allocate read buffer.
+    //
+    Private->ReadBufferSize = EMU_SNP_TAP_READ_BUFFER_SIZE;
+    Private->ReadBuffer = malloc (Private->ReadBufferSize);
+    if (Private->ReadBuffer == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      goto ErrorExit;
+    }
+
+    Private->PendingLength = 0;
+  }
+
+  Private->Mode->State = EfiSimpleNetworkStarted;
+
+  return Status;
+
+DeviceErrorExit:
+  Status = EFI_DEVICE_ERROR;
+ErrorExit:
+  if (Private->TapFd >= 0) {
+    close (Private->TapFd);
+    Private->TapFd = -1;
+  }
+  return Status;
 }
 
 /**
@@ -108,7 +360,33 @@ EmuSnpStop (
 
   Private = EMU_SNP_PRIVATE_DATA_FROM_THIS (This);
 
-  return EFI_UNSUPPORTED;
+  switch ( Private->Mode->State ) {
+    case EfiSimpleNetworkStarted:
+      break;
+
+    case EfiSimpleNetworkStopped:
+      return EFI_NOT_STARTED;
+      break;
+
+    default:
+      return EFI_DEVICE_ERROR;
+      break;
+  }
+
+  if (Private->TapFd >= 0) {
+    close (Private->TapFd);
+    Private->TapFd = -1;
+  }
+
+  if (Private->ReadBuffer != NULL) {
+    free (Private->ReadBuffer);
+    Private->ReadBuffer = NULL;
+  }
+
+  Private->PendingLength = 0;
+  Private->Mode->State = EfiSimpleNetworkStopped;
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -148,7 +426,29 @@ EmuSnpInitialize (
 
   Private = EMU_SNP_PRIVATE_DATA_FROM_THIS (This);
 
-  return EFI_UNSUPPORTED;
+  switch ( Private->Mode->State ) {
+    case EfiSimpleNetworkStarted:
+      break;
+
+    case EfiSimpleNetworkStopped:
+      return EFI_NOT_STARTED;
+      break;
+
+    default:
+      return EFI_DEVICE_ERROR;
+      break;
+  }
+
+  Private->Mode->MCastFilterCount = 0;
+  Private->Mode->ReceiveFilterSetting = 0;
+  ZeroMem (Private->Mode->MCastFilter, sizeof (Private->Mode->MCastFilter));
+
+  Private->PendingLength = 0;
+  EmuSnpResetStatistics (Private);
+
+  Private->Mode->State = EfiSimpleNetworkInitialized;
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -177,7 +477,22 @@ EmuSnpReset (
 
   Private = EMU_SNP_PRIVATE_DATA_FROM_THIS (This);
 
-  return EFI_UNSUPPORTED;
+  switch ( Private->Mode->State ) {
+    case EfiSimpleNetworkInitialized:
+      break;
+
+    case EfiSimpleNetworkStopped:
+      return EFI_NOT_STARTED;
+      break;
+
+    default:
+      return EFI_DEVICE_ERROR;
+      break;
+  }
+
+  Private->PendingLength = 0;
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -202,7 +517,32 @@ EmuSnpShutdown (
 
   Private = EMU_SNP_PRIVATE_DATA_FROM_THIS (This);
 
-  return EFI_UNSUPPORTED;
+  switch ( Private->Mode->State ) {
+    case EfiSimpleNetworkInitialized:
+      break;
+
+    case EfiSimpleNetworkStopped:
+      return EFI_NOT_STARTED;
+      break;
+
+    default:
+      return EFI_DEVICE_ERROR;
+      break;
+  }
+
+  Private->Mode->State = EfiSimpleNetworkStarted;
+
+  Private->Mode->ReceiveFilterSetting = 0;
+  Private->Mode->MCastFilterCount = 0;
+  ZeroMem (Private->Mode->MCastFilter, sizeof (Private->Mode->MCastFilter));
+
+  //
+  // The TAP device stays attached until Stop(), but nothing that was
+  // received before the shutdown may be handed to the next owner.
+  //
+  Private->PendingLength = 0;
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -239,11 +579,37 @@ EmuSnpReceiveFilters (
   IN EFI_MAC_ADDRESS                              *MCastFilter OPTIONAL
   )
 {
-  EMU_SNP_PRIVATE    *Private;
+  EMU_SNP_PRIVATE          *Private;
+  EFI_SIMPLE_NETWORK_MODE  *Mode;
 
   Private = EMU_SNP_PRIVATE_DATA_FROM_THIS (This);
+  Mode    = Private->Mode;
 
-  return EFI_UNSUPPORTED;
+  if (Mode->State != EfiSimpleNetworkInitialized) {
+    return (Mode->State == EfiSimpleNetworkStopped) ? EFI_NOT_STARTED : EFI_DEVICE_ERROR;
+  }
+
+  if (((Enable | Disable) & ~Mode->ReceiveFilterMask) != 0) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (!ResetMCastFilter && (MCastFilterCnt != 0)) {
+    if ((MCastFilterCnt > Mode->MaxMCastFilterCount) || (MCastFilter == NULL)) {
+      return EFI_INVALID_PARAMETER;
+    }
+  }
+
+  Mode->ReceiveFilterSetting = (Mode->ReceiveFilterSetting | Enable) & ~Disable;
+
+  if (ResetMCastFilter) {
+    Mode->MCastFilterCount = 0;
+    ZeroMem (Mode->MCastFilter, sizeof (Mode->MCastFilter));
+  } else if (MCastFilterCnt != 0) {
+    Mode->MCastFilterCount = (UINT32) MCastFilterCnt;
+    CopyMem (Mode->MCastFilter, MCastFilter, MCastFilterCnt * sizeof (EFI_MAC_ADDRESS));
+  }
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -305,10 +671,38 @@ EmuSnpStatistics (
   )
 {
   EMU_SNP_PRIVATE    *Private;
+  EFI_STATUS         Status;
 
   Private = EMU_SNP_PRIVATE_DATA_FROM_THIS (This);
 
-  return EFI_UNSUPPORTED;
+  if (Private->Mode->State != EfiSimpleNetworkInitialized) {
+    return (Private->Mode->State == EfiSimpleNetworkStopped) ? EFI_NOT_STARTED : EFI_DEVICE_ERROR;
+  }
+
+  if (!Reset && (StatisticsSize == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Status = EFI_SUCCESS;
+  if (StatisticsSize != NULL) {
+    if ((*StatisticsSize != 0) && (StatisticsTable == NULL)) {
+      return EFI_INVALID_PARAMETER;
+    }
+
+    if (*StatisticsSize < sizeof (EFI_NETWORK_STATISTICS)) {
+      Status = EFI_BUFFER_TOO_SMALL;
+    } else {
+      CopyMem (StatisticsTable, &Private->Statistics, sizeof (EFI_NETWORK_STATISTICS));
+    }
+
+    *StatisticsSize = sizeof (EFI_NETWORK_STATISTICS);
+  }
+
+  if (Reset && !EFI_ERROR (Status)) {
+    EmuSnpResetStatistics (Private);
+  }
+
+  return Status;
 }
 
 /**
@@ -419,7 +813,19 @@ EmuSnpGetStatus (
 
   Private = EMU_SNP_PRIVATE_DATA_FROM_THIS (This);
 
-  return EFI_UNSUPPORTED;
+  //
+  // Transmit() writes the frame synchronously, so the buffer can always be
+  // recycled right away.
+  //
+  if (TxBuf != NULL) {
+    *((UINT8 **)TxBuf) =  (UINT8 *)1;
+  }
+
+  if ( InterruptStatus != NULL ) {
+    *InterruptStatus = EFI_SIMPLE_NETWORK_TRANSMIT_INTERRUPT;
+  }
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -467,10 +873,58 @@ EmuSnpTransmit (
   )
 {
   EMU_SNP_PRIVATE    *Private;
+  ETHERNET_HEADER    *EnetHeader;
+  ssize_t            Result;
 
   Private = EMU_SNP_PRIVATE_DATA_FROM_THIS (This);
 
-  return EFI_UNSUPPORTED;
+  if (Private->Mode->State < EfiSimpleNetworkStarted) {
+    return EFI_NOT_STARTED;
+  }
+
+  if ( HeaderSize != 0 ) {
+    if ((DestAddr == NULL) || (Protocol == NULL) || (HeaderSize != Private->Mode->MediaHeaderSize)) {
+      return EFI_INVALID_PARAMETER;
+    }
+
+    if (SrcAddr == NULL) {
+      SrcAddr = &Private->Mode->CurrentAddress;
+    }
+
+    EnetHeader = (ETHERNET_HEADER *) Buffer;
+
+    CopyMem (EnetHeader->DstAddr, DestAddr, NET_ETHER_ADDR_LEN);
+    CopyMem (EnetHeader->SrcAddr, SrcAddr, NET_ETHER_ADDR_LEN);
+
+    EnetHeader->Type = HTONS(*Protocol);
+  }
+
+  if (BufferSize < sizeof (ETHERNET_HEADER)) {
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  Private->Statistics.TxTotalFrames++;
+
+  Result = write (Private->TapFd, Buffer, BufferSize);
+  if (Result < 0) {
+    Private->Statistics.TxDroppedFrames++;
+    //
+    // EAGAIN means the host side of the interface is not draining its queue.
+    //
+    return (errno == EAGAIN) ? EFI_NOT_READY : EFI_DEVICE_ERROR;
+  }
+
+  Private->Statistics.TxGoodFrames++;
+  Private->Statistics.TxTotalBytes += BufferSize;
+  EmuSnpCountFrame (
+    Private->Mode,
+    ((ETHERNET_HEADER *) Buffer)->DstAddr,
+    &Private->Statistics.TxUnicastFrames,
+    &Private->Statistics.TxBroadcastFrames,
+    &Private->Statistics.TxMulticastFrames
+    );
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -517,10 +971,85 @@ EmuSnpReceive (
   )
 {
   EMU_SNP_PRIVATE    *Private;
+  ETHERNET_HEADER    *EnetHeader;
+  ssize_t            Result;
 
   Private = EMU_SNP_PRIVATE_DATA_FROM_THIS (This);
 
-  return EFI_UNSUPPORTED;
+  if (Private->Mode->State < EfiSimpleNetworkStarted) {
+    return EFI_NOT_STARTED;
+  }
+
+  EnetHeader = Private->ReadBuffer;
+
+  //
+  // Do we have a frame left over from a previous call?  If not, read until
+  // a frame passes the receive filters or the device runs dry.
+  //
+  while (Private->PendingLength == 0) {
+    Result = read (Private->TapFd, Private->ReadBuffer, Private->ReadBufferSize);
+    if (Result < 0) {
+      // EAGAIN means that there's no I/O outstanding against this file descriptor.
+      return (errno == EAGAIN) ? EFI_NOT_READY : EFI_DEVICE_ERROR;
+    }
+
+    if (Result == 0) {
+      return EFI_NOT_READY;
+    }
+
+    Private->Statistics.RxTotalFrames++;
+    Private->Statistics.RxTotalBytes += Result;
+
+    if ((UINTN) Result < sizeof (ETHERNET_HEADER)) {
+      Private->Statistics.RxUndersizeFrames++;
+      continue;
+    }
+
+    if (!EmuSnpAcceptFrame (Private, EnetHeader)) {
+      Private->Statistics.RxDroppedFrames++;
+      continue;
+    }
+
+    Private->PendingLength = Result;
+  }
+
+  if (Private->PendingLength > *BufferSize) {
+    *BufferSize = Private->PendingLength;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  CopyMem (Buffer, EnetHeader, Private->PendingLength);
+  *BufferSize = Private->PendingLength;
+
+  if (HeaderSize != NULL) {
+    *HeaderSize = sizeof (ETHERNET_HEADER);
+  }
+
+  if (DestAddr != NULL) {
+    ZeroMem (DestAddr, sizeof (EFI_MAC_ADDRESS));
+    CopyMem (DestAddr, EnetHeader->DstAddr, NET_ETHER_ADDR_LEN);
+  }
+
+  if (SrcAddr != NULL) {
+    ZeroMem (SrcAddr, sizeof (EFI_MAC_ADDRESS));
+    CopyMem (SrcAddr, EnetHeader->SrcAddr, NET_ETHER_ADDR_LEN);
+  }
+
+  if (Protocol != NULL) {
+    *Protocol = NTOHS (EnetHeader->Type);
+  }
+
+  Private->Statistics.RxGoodFrames++;
+  EmuSnpCountFrame (
+    Private->Mode,
+    EnetHeader->DstAddr,
+    &Private->Statistics.RxUnicastFrames,
+    &Private->Statistics.RxBroadcastFrames,
+    &Private->Statistics.RxMulticastFrames
+    );
+
+  Private->PendingLength = 0;
+  return EFI_SUCCESS;
 }
 
 
@@ -541,6 +1070,54 @@ EMU_SNP_PROTOCOL gEmuSnpProtocol = {
   GasketSnpReceive
 };
 
+EFI_STATUS
+GetInterfaceMacAddr (
+  EMU_SNP_PRIVATE    *Private
+  )
+{
+  EFI_STATUS          Status;
+  struct ifreq        IfReq;
+  int                 Fd;
+
+  //
+  // Convert the interface name to ASCII so we can find it.
+  //
+  Private->InterfaceName = malloc (StrSize (Private->Thunk->ConfigString));
+  if (Private->InterfaceName == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  UnicodeStrToAsciiStr (Private->Thunk->ConfigString, Private->InterfaceName);
+
+  Fd = socket (AF_INET, SOCK_DGRAM, 0);
+  if (Fd < 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  ZeroMem (&IfReq, sizeof (IfReq));
+  AsciiStrnCpy (IfReq.ifr_name, Private->InterfaceName, sizeof (IfReq.ifr_name) - 1);
+
+  Status = EFI_NOT_FOUND;
+  if (ioctl (Fd, SIOCGIFHWADDR, &IfReq) == 0) {
+    CopyMem (&Private->MacAddress, IfReq.ifr_hwaddr.sa_data, NET_ETHER_ADDR_LEN);
+    Status = EFI_SUCCESS;
+  } else {
+    //
+    // The TAP interface may not exist yet.  Make up a locally administered
+    // address so the emulator still has a usable station address.
+    //
+    ZeroMem (&Private->MacAddress, sizeof (EFI_MAC_ADDRESS));
+    Private->MacAddress.Addr[0] = 0x02;
+    Private->MacAddress.Addr[1] = 0x00;
+    Private->MacAddress.Addr[2] = 0x45;
+    Private->MacAddress.Addr[3] = 0x4D;
+    Private->MacAddress.Addr[4] = 0x55;
+  }
+
+  close (Fd);
+  return Status;
+}
+
 EFI_STATUS
 EmuSnpThunkOpen (
   IN  EMU_IO_THUNK_PROTOCOL   *This
@@ -562,9 +1139,13 @@ EmuSnpThunkOpen (
   }
 
 
+  ZeroMem (Private, sizeof (EMU_SNP_PRIVATE));
   Private->Signature = EMU_SNP_PRIVATE_SIGNATURE;
   Private->Thunk     = This;
+  Private->TapFd     = -1;
   CopyMem (&Private->EmuSnp, &gEmuSnpProtocol, sizeof (gEmuSnpProtocol));
+  EmuSnpResetStatistics (Private);
+  GetInterfaceMacAddr (Private);
 
   This->Interface = &Private->EmuSnp;
   This->Private   = Private;
@@ -584,6 +1165,18 @@ EmuSnpThunkClose (
   }
 
   Private = This->Private;
+  if (Private->TapFd >= 0) {
+    close (Private->TapFd);
+  }
+
+  if (Private->ReadBuffer != NULL) {
+    free (Private->ReadBuffer);
+  }
+
+  if (Private->InterfaceName != NULL) {
+    free (Private->InterfaceName);
+  }
+
   free (Private);
 
   return EFI_SUCCESS;
@@ -43,9 +43,37 @@ FatFreeODir (
     FatFreeDirEnt (DirEnt);
   }
 
+  if (ODir->LongNameHashTable != NULL) {
+    FreePool (ODir->LongNameHashTable);
+  }
+
+  if (ODir->ShortNameHashTable != NULL) {
+    FreePool (ODir->ShortNameHashTable);
+  }
+
   FreePool (ODir);
 }
 
+/**
+
+  Get the approximate memory held by the directory structure.
+
+  @param  ODir                  - The directory structure.
+
+  @return The size in bytes.
+
+**/
+STATIC
+UINTN
+FatODirSize (
+  IN FAT_ODIR    *ODir
+  )
+{
+  return sizeof (FAT_ODIR) +
+         2 * ODir->HashTableSize * sizeof (FAT_DIRENT *) +
+         ODir->DirEntCount * (sizeof (FAT_DIRENT) + sizeof (CHAR16) * FAT_NAME_LEN);
+}
+
 /**
 
   Allocate the directory structure.
@@ -69,6 +97,16 @@ FatAllocateODir (
     ODir->Signature = FAT_ODIR_SIGNATURE;
     InitializeListHead (&ODir->ChildList);
     ODir->CurrentCursor = &ODir->ChildList;
+    //
+    // Start with small hash tables, they grow with the directory
+    //
+    ODir->HashTableSize       = HASH_TABLE_MIN_SIZE;
+    ODir->LongNameHashTable   = AllocateZeroPool (HASH_TABLE_MIN_SIZE * sizeof (FAT_DIRENT *));
+    ODir->ShortNameHashTable  = AllocateZeroPool (HASH_TABLE_MIN_SIZE * sizeof (FAT_DIRENT *));
+    if (ODir->LongNameHashTable == NULL || ODir->ShortNameHashTable == NULL) {
+      FatFreeODir (ODir);
+      ODir = NULL;
+    }
   }
 
   return ODir;
@@ -99,19 +137,22 @@ FatDiscardODir (
     //
     ODir->DirCacheTag = OFile->FileCluster;
     InsertHeadList (&Volume->DirCacheList, &ODir->DirCacheLink);
-    if (Volume->DirCacheCount == FAT_MAX_DIR_CACHE_COUNT) {
-      //
-      // Replace the least recent used directory
-      //
+    Volume->DirCacheCount++;
+    Volume->DirCacheSize += FatODirSize (ODir);
+    //
+    // Replace the least recent used directories while the cache is over its
+    // count or memory budget, but always keep the directory just discarded
+    //
+    while (Volume->DirCacheCount > FAT_MAX_DIR_CACHE_COUNT ||
+           (Volume->DirCacheSize > FAT_MAX_DIR_CACHE_SIZE && Volume->DirCacheCount > 1)) {
       ODir = ODIR_FROM_DIRCACHELINK (Volume->DirCacheList.BackLink);
       RemoveEntryList (&ODir->DirCacheLink);
-    } else {
-      //
-      // No need to find a replace
-      //
-      Volume->DirCacheCount++;
-      ODir = NULL;
+      Volume->DirCacheCount--;
+      Volume->DirCacheSize -= FatODirSize (ODir);
+      FatFreeODir (ODir);
     }
+
+    ODir = NULL;
   }
   //
   // Release ODir Structure
@@ -153,6 +194,7 @@ FatRequestODir (
     if (CurrentODir->DirCacheTag == DirCacheTag) {
       RemoveEntryList (&CurrentODir->DirCacheLink);
       Volume->DirCacheCount--;
+      Volume->DirCacheSize -= FatODirSize (CurrentODir);
       ODir = CurrentODir;
       break;
     }
@@ -187,4 +229,6 @@ FatCleanupODirCache (
     FatFreeODir (ODir);
     Volume->DirCacheCount--;
   }
+
+  Volume->DirCacheSize = 0;
 }
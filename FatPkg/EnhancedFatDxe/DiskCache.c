@@ -87,16 +87,21 @@ FatFlushDataCacheRange (
 
 /**
 
-  Exchange the cache page with the image on the disk
+  Exchange the cache pages with the image on the disk
+
+  The PageCount pages are consecutive both on the disk and in the cache, so
+  they are transferred with a single disk access. When storing, all but the
+  last page must be complete.
 
   @param  Volume                - FAT file system volume.
   @param  DataType              - Indicate the cache type.
-  @param  IoMode                - Indicate whether to load this page from disk or store this page to disk.
-  @param  CacheTag              - The Cache Tag for the current cache page.
+  @param  IoMode                - Indicate whether to load these pages from disk or store these pages to disk.
+  @param  CacheTag              - The Cache Tag for the first cache page.
+  @param  PageCount             - The number of cache pages to exchange.
   @param  Task                    point to task instance.
 
-  @retval EFI_SUCCESS           - Cache page exchanged successfully.
-  @return Others                - An error occurred when exchanging cache page.
+  @retval EFI_SUCCESS           - Cache pages exchanged successfully.
+  @return Others                - An error occurred when exchanging cache pages.
 
 **/
 STATIC
@@ -106,14 +111,17 @@ FatExchangeCachePage (
   IN CACHE_DATA_TYPE    DataType,
   IN IO_MODE            IoMode,
   IN CACHE_TAG          *CacheTag,
+  IN UINTN              PageCount,
   IN FAT_TASK           *Task
   )
 {
   EFI_STATUS  Status;
   UINTN       GroupNo;
   UINTN       PageNo;
+  UINTN       PageSize;
   UINTN       WriteCount;
   UINTN       RealSize;
+  UINTN       Index;
   UINT64      EntryPos;
   UINT64      MaxSize;
   DISK_CACHE  *DiskCache;
@@ -124,11 +132,14 @@ FatExchangeCachePage (
   PageNo        = CacheTag->PageNo;
   GroupNo       = PageNo & DiskCache->GroupMask;
   PageAlignment = DiskCache->PageAlignment;
+  PageSize      = (UINTN)1 << PageAlignment;
   PageAddress   = DiskCache->CacheBase + (GroupNo << PageAlignment);
   EntryPos      = DiskCache->BaseAddress + LShiftU64 (PageNo, PageAlignment);
-  RealSize      = CacheTag->RealSize;
+  ASSERT (PageCount > 0 && GroupNo + PageCount - 1 <= DiskCache->GroupMask);
+
+  RealSize      = ((PageCount - 1) << PageAlignment) + CacheTag[PageCount - 1].RealSize;
   if (IoMode == ReadDisk) {
-    RealSize  = (UINTN)1 << PageAlignment;
+    RealSize  = PageCount << PageAlignment;
     MaxSize   = DiskCache->LimitAddress - EntryPos;
     if (MaxSize < RealSize) {
       DEBUG ((EFI_D_INFO, "FatDiskIo: Cache Page OutBound occurred! \n"));
@@ -153,11 +164,106 @@ FatExchangeCachePage (
     EntryPos += Volume->FatSize;
   } while (--WriteCount > 0);
 
-  CacheTag->Dirty     = FALSE;
-  CacheTag->RealSize  = RealSize;
+  for (Index = 0; Index < PageCount; Index++) {
+    ASSERT (RealSize > (Index << PageAlignment));
+    CacheTag[Index].PageNo    = PageNo + Index;
+    CacheTag[Index].Dirty     = FALSE;
+    CacheTag[Index].RealSize  = MIN (PageSize, RealSize - (Index << PageAlignment));
+  }
+
   return EFI_SUCCESS;
 }
 
+/**
+
+  Count the dirty cache pages which can be written back together with the
+  given one, that is, the following pages which are dirty and consecutive
+  both on the disk and in the cache.
+
+  @param  DiskCache             - The disk cache.
+  @param  CacheTag              - The Cache Tag for the first, dirty cache page.
+
+  @return The number of cache pages in the run.
+
+**/
+STATIC
+UINTN
+FatDirtyCacheRun (
+  IN DISK_CACHE         *DiskCache,
+  IN CACHE_TAG          *CacheTag
+  )
+{
+  UINTN       GroupNo;
+  UINTN       PageSize;
+  UINTN       Count;
+  CACHE_TAG   *NextTag;
+
+  GroupNo   = (UINTN) (CacheTag - DiskCache->CacheTag);
+  PageSize  = (UINTN)1 << DiskCache->PageAlignment;
+
+  for (Count = 1; GroupNo + Count <= DiskCache->GroupMask; Count++) {
+    //
+    // Only the last page of the run may be incomplete
+    //
+    if (CacheTag[Count - 1].RealSize != PageSize) {
+      break;
+    }
+
+    NextTag = &CacheTag[Count];
+    if (NextTag->RealSize == 0 || !NextTag->Dirty || NextTag->PageNo != CacheTag->PageNo + Count) {
+      break;
+    }
+  }
+
+  return Count;
+}
+
+/**
+
+  Count the cache pages to load from disk on a cache miss of PageNo.
+
+  The pages following PageNo are loaded together with it while sequential
+  access is detected, up to DiskCache->ReadAhead pages. The run stops at the
+  end of the cache, at the end of the cached range of the disk, and at any
+  cache page that is dirty or already holds the page it would be loaded with.
+
+  @param  DiskCache             - The disk cache.
+  @param  PageNo                - The missed page.
+  @param  CacheTag              - The Cache Tag for PageNo.
+
+  @return The number of cache pages to load.
+
+**/
+STATIC
+UINTN
+FatReadAheadCount (
+  IN DISK_CACHE         *DiskCache,
+  IN UINTN              PageNo,
+  IN CACHE_TAG          *CacheTag
+  )
+{
+  UINTN       GroupNo;
+  UINTN       MaxCount;
+  UINTN       Count;
+  CACHE_TAG   *NextTag;
+
+  GroupNo   = PageNo & DiskCache->GroupMask;
+  MaxCount  = MIN (DiskCache->ReadAhead, DiskCache->GroupMask + 1 - GroupNo);
+
+  for (Count = 1; Count < MaxCount; Count++) {
+    NextTag = &CacheTag[Count];
+    if (NextTag->RealSize > 0 && (NextTag->Dirty || NextTag->PageNo == PageNo + Count)) {
+      break;
+    }
+
+    if (DiskCache->BaseAddress + LShiftU64 (PageNo + Count, DiskCache->PageAlignment) >= DiskCache->LimitAddress) {
+      break;
+    }
+  }
+
+  return Count;
+}
+
 /**
 
   Get one cache page by specified PageNo.
@@ -182,6 +288,8 @@ FatGetCachePage (
 {
   EFI_STATUS  Status;
   UINTN       OldPageNo;
+  UINTN       PageCount;
+  DISK_CACHE  *DiskCache;
 
   OldPageNo = CacheTag->PageNo;
   if (CacheTag->RealSize > 0 && OldPageNo == PageNo) {
@@ -191,20 +299,33 @@ FatGetCachePage (
     return EFI_SUCCESS;
   }
 
+  DiskCache = &Volume->DiskCache[CacheDataType];
   //
-  // Write dirty cache page back to disk
+  // Write dirty cache page back to disk, along with the dirty pages following it
   //
   if (CacheTag->RealSize > 0 && CacheTag->Dirty) {
-    Status = FatExchangeCachePage (Volume, CacheDataType, WriteDisk, CacheTag, NULL);
+    PageCount = FatDirtyCacheRun (DiskCache, CacheTag);
+    Status    = FatExchangeCachePage (Volume, CacheDataType, WriteDisk, CacheTag, PageCount, NULL);
     if (EFI_ERROR (Status)) {
       return Status;
     }
   }
   //
+  // A miss right behind the last loaded run indicates sequential access;
+  // grow the read-ahead window then, otherwise shrink it back to one page
+  //
+  if (PageNo == DiskCache->NextPageNo) {
+    DiskCache->ReadAhead = MIN (DiskCache->ReadAhead * 2, FAT_CACHE_READAHEAD_MAX_COUNT);
+  } else {
+    DiskCache->ReadAhead = 1;
+  }
+  //
   // Load new data from disk;
   //
-  CacheTag->PageNo  = PageNo;
-  Status            = FatExchangeCachePage (Volume, CacheDataType, ReadDisk, CacheTag, NULL);
+  PageCount             = FatReadAheadCount (DiskCache, PageNo, CacheTag);
+  CacheTag->PageNo      = PageNo;
+  Status                = FatExchangeCachePage (Volume, CacheDataType, ReadDisk, CacheTag, PageCount, NULL);
+  DiskCache->NextPageNo = PageNo + PageCount;
 
   return Status;
 }
@@ -404,6 +525,7 @@ FatVolumeFlushCache (
   CACHE_DATA_TYPE CacheDataType;
   UINTN           GroupIndex;
   UINTN           GroupMask;
+  UINTN           PageCount;
   DISK_CACHE      *DiskCache;
   CACHE_TAG       *CacheTag;
 
@@ -414,13 +536,16 @@ FatVolumeFlushCache (
       // Data cache or fat cache is dirty, write the dirty data back
       //
       GroupMask = DiskCache->GroupMask;
-      for (GroupIndex = 0; GroupIndex <= GroupMask; GroupIndex++) {
-        CacheTag = &DiskCache->CacheTag[GroupIndex];
+      for (GroupIndex = 0; GroupIndex <= GroupMask; GroupIndex += PageCount) {
+        CacheTag  = &DiskCache->CacheTag[GroupIndex];
+        PageCount = 1;
         if (CacheTag->RealSize > 0 && CacheTag->Dirty) {
           //
-          // Write back all Dirty Data Cache Page to disk
+          // Write back all Dirty Data Cache Page to disk, coalescing
+          // consecutive pages into one write
           //
-          Status = FatExchangeCachePage (Volume, CacheDataType, WriteDisk, CacheTag, Task);
+          PageCount = FatDirtyCacheRun (DiskCache, CacheTag);
+          Status    = FatExchangeCachePage (Volume, CacheDataType, WriteDisk, CacheTag, PageCount, Task);
           if (EFI_ERROR (Status)) {
             return Status;
           }
@@ -478,6 +603,8 @@ FatInitializeDiskCache (
   DiskCache[CacheFat].GroupMask      = FatCacheGroupCount - 1;
   DiskCache[CacheFat].BaseAddress    = Volume->FatPos;
   DiskCache[CacheFat].LimitAddress   = Volume->FatPos + Volume->FatSize;
+  DiskCache[CacheData].ReadAhead     = 1;
+  DiskCache[CacheFat].ReadAhead      = 1;
   FatCacheSize                        = FatCacheGroupCount << DiskCache[CacheFat].PageAlignment;
   DataCacheSize                       = FAT_DATACACHE_GROUP_COUNT << DiskCache[CacheData].PageAlignment;
   //
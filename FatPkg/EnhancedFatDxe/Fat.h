@@ -89,6 +89,10 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define FAT_DATACACHE_GROUP_COUNT         64
 #define FAT_FATCACHE_GROUP_MIN_COUNT      1
 #define FAT_FATCACHE_GROUP_MAX_COUNT      16
+//
+// Maximum number of cache pages loaded at once when sequential access is detected
+//
+#define FAT_CACHE_READAHEAD_MAX_COUNT     8
 
 //
 // Used in 8.3 generation algorithm
@@ -110,7 +114,10 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define LC_ISO_639_2_ENTRY_SIZE 3
 #define MAX_LANG_CODE_SIZE      100
 
-#define FAT_MAX_DIR_CACHE_COUNT 8
+#define FAT_MAX_DIR_CACHE_COUNT 64
+#define FAT_MAX_DIR_CACHE_SIZE  0x200000  // Memory budget of the directory cache in bytes
+#define FAT_FREE_BITMAP_CHUNK   0x1000  // FAT entries read at a time to build the free cluster bitmap
+#define FAT_EXTENT_MAP_MIN_SIZE 0x10    // Initial number of runs in an open file's extent map
 #define FAT_MAX_DIRENTRY_COUNT  0xFFFF
 typedef CHAR8                   LC_ISO_639_2;
 
@@ -162,14 +169,18 @@ typedef struct {
   BOOLEAN   Dirty;
   UINT8     PageAlignment;
   UINTN     GroupMask;
+  UINTN     NextPageNo;   // Page following the last run loaded from disk
+  UINTN     ReadAhead;    // Number of pages to load on the next sequential miss
   CACHE_TAG CacheTag[FAT_DATACACHE_GROUP_COUNT];
 } DISK_CACHE;
 
 //
-// Hash table size
+// Hash table size, doubled whenever a directory holds more than
+// HASH_TABLE_LOAD_FACTOR entries per bucket
 //
-#define HASH_TABLE_SIZE  0x400
-#define HASH_TABLE_MASK  (HASH_TABLE_SIZE - 1)
+#define HASH_TABLE_MIN_SIZE     0x40
+#define HASH_TABLE_MAX_SIZE     0x4000
+#define HASH_TABLE_LOAD_FACTOR  2
 
 //
 // The directory entry for opened directory
@@ -202,8 +213,10 @@ struct _FAT_ODIR {
   BOOLEAN             EndOfDir;               // Indicate whether we have reached the end of the directory
   LIST_ENTRY          DirCacheLink;           // Linked in Volume->DirCacheList when discarded
   UINTN               DirCacheTag;            // The identification of the directory when in directory cache
-  FAT_DIRENT          *LongNameHashTable[HASH_TABLE_SIZE];
-  FAT_DIRENT          *ShortNameHashTable[HASH_TABLE_SIZE];
+  UINTN               DirEntCount;            // Number of directory entries in the hash tables
+  UINTN               HashTableSize;          // Number of buckets in each hash table
+  FAT_DIRENT          **LongNameHashTable;
+  FAT_DIRENT          **ShortNameHashTable;
 };
 
 typedef struct {
@@ -235,6 +248,15 @@ typedef struct {
   LIST_ENTRY          Link;
 } FAT_SUBTASK;
 
+//
+// A run of consecutive clusters in the cluster chain of a file
+//
+typedef struct {
+  UINTN               FileIndex;              // Index of the first cluster of the run within the file
+  UINTN               Cluster;                // First cluster of the run on the volume
+  UINTN               Count;                  // Number of clusters in the run
+} FAT_EXTENT;
+
 //
 // FAT_OFILE - Each opened file
 //
@@ -278,6 +300,14 @@ struct _FAT_OFILE {
   UINT64              PosDisk;  // on the disk
   UINTN               PosRem;   // remaining in this disk run
   //
+  // Run-length encoded map of the cluster chain, extended as the
+  // chain is traversed and discarded when the chain is shortened
+  //
+  FAT_EXTENT          *Extents;
+  UINTN               ExtentCount;
+  UINTN               ExtentMax;
+  BOOLEAN             ExtentsComplete;  // The map reaches the end of the chain
+  //
   // The opened parent, full path length and currently opened child files
   //
   FAT_OFILE           *Parent;
@@ -341,6 +371,7 @@ struct _FAT_VOLUME {
   FAT_INFO_SECTOR                 FatInfoSector;  // Free cluster info
   UINTN                           FreeInfoPos;    // Pos with the free cluster info
   BOOLEAN                         FreeInfoValid;  // If free cluster info is valid
+  UINT8                           *FreeBitmap;    // One bit per cluster, set if the cluster is in use
   //
   // Unpacked Fat BPB info
   //
@@ -375,6 +406,7 @@ struct _FAT_VOLUME {
   //
   LIST_ENTRY                      DirCacheList;
   UINTN                           DirCacheCount;
+  UINTN                           DirCacheSize;   // Approximate memory held by the cached directories
 
   //
   // Disk Cache for this volume
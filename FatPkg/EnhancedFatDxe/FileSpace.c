@@ -17,6 +17,35 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include "Fat.h"
 
 
+/**
+
+  Get the offset of the FAT entry within the FAT, which is identified with the Index.
+
+  @param  Volume                - FAT file system volume.
+  @param  Index                 - The index of the FAT entry of the volume.
+
+  @return The byte offset of the FAT entry from the start of the FAT
+
+**/
+STATIC
+UINTN
+FatEntryOffset (
+  IN FAT_VOLUME       *Volume,
+  IN UINTN            Index
+  )
+{
+  switch (Volume->FatType) {
+  case Fat12:
+    return FAT_POS_FAT12 (Index);
+
+  case Fat16:
+    return FAT_POS_FAT16 (Index);
+
+  default:
+    return FAT_POS_FAT32 (Index);
+  }
+}
+
 /**
 
   Get the FAT entry of the volume, which is identified with the Index.
@@ -34,7 +63,6 @@ FatLoadFatEntry (
   IN UINTN            Index
   )
 {
-  UINTN       Pos;
   EFI_STATUS  Status;
 
   if (Index > (Volume->MaxCluster + 1)) {
@@ -42,24 +70,9 @@ FatLoadFatEntry (
     return &Volume->FatEntryBuffer;
   }
   //
-  // Compute buffer position needed
-  //
-  switch (Volume->FatType) {
-  case Fat12:
-    Pos = FAT_POS_FAT12 (Index);
-    break;
-
-  case Fat16:
-    Pos = FAT_POS_FAT16 (Index);
-    break;
-
-  default:
-    Pos = FAT_POS_FAT32 (Index);
-  }
-  //
   // Set the position and read the buffer
   //
-  Volume->FatEntryPos = Volume->FatPos + Pos;
+  Volume->FatEntryPos = Volume->FatPos + FatEntryOffset (Volume, Index);
   Status = FatDiskIo (
              Volume,
              ReadFat,
@@ -77,9 +90,11 @@ FatLoadFatEntry (
 
 /**
 
-  Get the FAT entry value of the volume, which is identified with the Index.
+  Decode the FAT entry of the volume, which is identified with the Index,
+  from the buffer it has been read into.
 
   @param  Volume                - FAT file system volume.
+  @param  Pos                   - The buffer holding the FAT entry.
   @param  Index                 - The index of the FAT entry of the volume.
 
   @return  The value of the FAT entry.
@@ -87,23 +102,17 @@ FatLoadFatEntry (
 **/
 STATIC
 UINTN
-FatGetFatEntry (
+FatDecodeFatEntry (
   IN FAT_VOLUME       *Volume,
+  IN VOID             *Pos,
   IN UINTN            Index
   )
 {
-  VOID    *Pos;
   UINT8   *En12;
   UINT16  *En16;
   UINT32  *En32;
   UINTN   Accum;
 
-  Pos = FatLoadFatEntry (Volume, Index);
-
-  if (Index > (Volume->MaxCluster + 1)) {
-    return (UINTN) -1;
-  }
-
   switch (Volume->FatType) {
   case Fat12:
     En12   = Pos;
@@ -127,6 +136,178 @@ FatGetFatEntry (
   return Accum;
 }
 
+/**
+
+  Get the FAT entry value of the volume, which is identified with the Index.
+
+  @param  Volume                - FAT file system volume.
+  @param  Index                 - The index of the FAT entry of the volume.
+
+  @return  The value of the FAT entry.
+
+**/
+STATIC
+UINTN
+FatGetFatEntry (
+  IN FAT_VOLUME       *Volume,
+  IN UINTN            Index
+  )
+{
+  VOID    *Pos;
+
+  Pos = FatLoadFatEntry (Volume, Index);
+
+  if (Index > (Volume->MaxCluster + 1)) {
+    return (UINTN) -1;
+  }
+
+  return FatDecodeFatEntry (Volume, Pos, Index);
+}
+
+/**
+
+  Check whether the cluster is in use according to the free cluster bitmap.
+
+  @param  Volume                - FAT file system volume.
+  @param  Index                 - The index of the cluster.
+
+  @retval TRUE                  - The cluster is in use.
+  @retval FALSE                 - The cluster is free.
+
+**/
+STATIC
+BOOLEAN
+FatClusterInUse (
+  IN FAT_VOLUME       *Volume,
+  IN UINTN            Index
+  )
+{
+  ASSERT (Volume->FreeBitmap != NULL);
+  return (BOOLEAN) ((Volume->FreeBitmap[Index / 8] & (1 << (Index % 8))) != 0);
+}
+
+/**
+
+  Mark the cluster as in use or free in the free cluster bitmap, if the bitmap has been built.
+
+  @param  Volume                - FAT file system volume.
+  @param  Index                 - The index of the cluster.
+  @param  InUse                 - TRUE if the cluster is in use, FALSE if it is free.
+
+**/
+STATIC
+VOID
+FatMarkCluster (
+  IN FAT_VOLUME       *Volume,
+  IN UINTN            Index,
+  IN BOOLEAN          InUse
+  )
+{
+  if (Volume->FreeBitmap == NULL || Index > (Volume->MaxCluster + 1)) {
+    return;
+  }
+
+  if (InUse) {
+    Volume->FreeBitmap[Index / 8] |= (UINT8) (1 << (Index % 8));
+  } else {
+    Volume->FreeBitmap[Index / 8] &= (UINT8) ~(1 << (Index % 8));
+  }
+}
+
+/**
+
+  Build the free cluster bitmap of the volume, reading the FAT in chunks of
+  FAT_FREE_BITMAP_CHUNK entries, and update the free cluster info from it.
+
+  @param  Volume                - FAT file system volume.
+
+  @retval EFI_SUCCESS           - The bitmap is built successfully.
+  @retval EFI_OUT_OF_RESOURCES  - Can not allocate memory for the bitmap.
+  @return other                 - An error occurred when reading the FAT.
+
+**/
+STATIC
+EFI_STATUS
+FatBuildFreeBitmap (
+  IN FAT_VOLUME       *Volume
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       *Bitmap;
+  UINT8       *Buffer;
+  UINTN       EntryCount;
+  UINTN       Start;
+  UINTN       Count;
+  UINTN       Index;
+  UINTN       Offset;
+  UINTN       Size;
+  UINTN       FreeCount;
+  UINTN       FirstFree;
+
+  ASSERT (Volume->FreeBitmap == NULL);
+
+  EntryCount = Volume->MaxCluster + 2;
+  Bitmap     = AllocateZeroPool ((EntryCount + 7) / 8);
+  if (Bitmap == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Buffer = AllocatePool (FAT_FREE_BITMAP_CHUNK * sizeof (UINT32));
+  if (Buffer == NULL) {
+    FreePool (Bitmap);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status    = EFI_SUCCESS;
+  FreeCount = 0;
+  FirstFree = EntryCount;
+  //
+  // The chunk size is even, so every chunk starts on a byte boundary with FAT12 too
+  //
+  for (Start = 0; Start < EntryCount; Start += Count) {
+    Count  = MIN (FAT_FREE_BITMAP_CHUNK, EntryCount - Start);
+    Offset = FatEntryOffset (Volume, Start);
+    Size   = FatEntryOffset (Volume, Start + Count) - Offset;
+    if (Volume->FatType == Fat12 && (Count & 1) != 0) {
+      Size += 1;
+    }
+
+    Status = FatDiskIo (Volume, ReadFat, Volume->FatPos + Offset, Size, Buffer, NULL);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    for (Index = Start; Index < Start + Count; Index++) {
+      if (Index < FAT_MIN_CLUSTER ||
+          FatDecodeFatEntry (Volume, Buffer + FatEntryOffset (Volume, Index) - Offset, Index) != FAT_CLUSTER_FREE) {
+        Bitmap[Index / 8] |= (UINT8) (1 << (Index % 8));
+      } else {
+        FreeCount += 1;
+        FirstFree  = MIN (FirstFree, Index);
+      }
+    }
+  }
+
+  FreePool (Buffer);
+  if (EFI_ERROR (Status)) {
+    FreePool (Bitmap);
+    return Status;
+  }
+
+  Volume->FreeBitmap                           = Bitmap;
+  Volume->FreeInfoValid                        = TRUE;
+  Volume->FatInfoSector.FreeInfo.ClusterCount  = (UINT32) FreeCount;
+  if (Volume->FatInfoSector.FreeInfo.NextCluster < FirstFree ||
+      Volume->FatInfoSector.FreeInfo.NextCluster > (Volume->MaxCluster + 1)) {
+    Volume->FatInfoSector.FreeInfo.NextCluster = (UINT32) MIN (FirstFree, Volume->MaxCluster + 1);
+  }
+
+  Volume->FatInfoSector.Signature          = FAT_INFO_SIGNATURE;
+  Volume->FatInfoSector.InfoBeginSignature = FAT_INFO_BEGIN_SIGNATURE;
+  Volume->FatInfoSector.InfoEndSignature   = FAT_INFO_END_SIGNATURE;
+  return EFI_SUCCESS;
+}
+
 /**
 
   Set the FAT entry value of the volume, which is identified with the Index.
@@ -171,6 +352,8 @@ FatSetFatEntry (
       Volume->FatInfoSector.FreeInfo.ClusterCount -= 1;
     }
   }
+
+  FatMarkCluster (Volume, Index, (BOOLEAN) (Value != FAT_CLUSTER_FREE));
   //
   // Make sure the entry is in memory
   //
@@ -262,11 +445,97 @@ FatFreeClusters (
   return EFI_SUCCESS;
 }
 
+/**
+
+  Find a free cluster in the free cluster bitmap.
+
+  The cluster following Hint is preferred if it is free, so that a growing file
+  stays contiguous. Otherwise the bitmap is searched from FreeInfo.NextCluster
+  for the first run of at least Needed free clusters; if there is no such run,
+  the first free cluster found is returned.
+
+  @param  Volume                - FAT file system volume.
+  @param  Hint                  - The current last cluster of the file, or 0.
+  @param  Needed                - The number of clusters the file still needs.
+
+  @return The index of the free cluster, or FAT_CLUSTER_LAST if the volume is full.
+
+**/
+STATIC
+UINTN
+FatFindFreeCluster (
+  IN FAT_VOLUME   *Volume,
+  IN UINTN        Hint,
+  IN UINTN        Needed
+  )
+{
+  UINTN Limit;
+  UINTN Index;
+  UINTN Scanned;
+  UINTN RunStart;
+  UINTN RunLength;
+  UINTN FirstFree;
+
+  Limit = Volume->MaxCluster + 1;
+  if (Hint >= FAT_MIN_CLUSTER && Hint < Limit && !FatClusterInUse (Volume, Hint + 1)) {
+    return Hint + 1;
+  }
+
+  Index = Volume->FatInfoSector.FreeInfo.NextCluster;
+  if (Index < FAT_MIN_CLUSTER || Index > Limit) {
+    Index = FAT_MIN_CLUSTER;
+  }
+
+  RunStart  = 0;
+  RunLength = 0;
+  FirstFree = 0;
+  for (Scanned = Limit - FAT_MIN_CLUSTER + 1; Scanned > 0; Scanned--, Index++) {
+    if (Index > Limit) {
+      //
+      // Wrap around; a run does not continue across the end of the volume
+      //
+      Index     = FAT_MIN_CLUSTER;
+      RunLength = 0;
+    }
+    //
+    // Skip whole bytes of allocated clusters at once
+    //
+    if ((Index % 8) == 0 && Index + 7 <= Limit && Scanned > 8 && Volume->FreeBitmap[Index / 8] == 0xFF) {
+      Index    += 7;
+      Scanned  -= 7;
+      RunLength = 0;
+      continue;
+    }
+
+    if (FatClusterInUse (Volume, Index)) {
+      RunLength = 0;
+      continue;
+    }
+
+    if (FirstFree == 0) {
+      FirstFree = Index;
+    }
+
+    if (RunLength == 0) {
+      RunStart = Index;
+    }
+
+    RunLength += 1;
+    if (RunLength >= Needed) {
+      return RunStart;
+    }
+  }
+
+  return (FirstFree != 0) ? FirstFree : (UINTN) FAT_CLUSTER_LAST;
+}
+
 /**
 
   Allocate a free cluster and return the cluster index.
 
   @param  Volume                - FAT file system volume.
+  @param  Hint                  - The current last cluster of the file, or 0.
+  @param  Needed                - The number of clusters the file still needs.
 
   @return The index of the free cluster
 
@@ -274,7 +543,9 @@ FatFreeClusters (
 STATIC
 UINTN
 FatAllocateCluster (
-  IN FAT_VOLUME   *Volume
+  IN FAT_VOLUME   *Volume,
+  IN UINTN        Hint,
+  IN UINTN        Needed
   )
 {
   UINTN Cluster;
@@ -286,6 +557,20 @@ FatAllocateCluster (
     return (UINTN) FAT_CLUSTER_LAST;
   }
 
+  if (Volume->FreeBitmap != NULL) {
+    Cluster = FatFindFreeCluster (Volume, Hint, Needed);
+    if (Cluster == (UINTN) FAT_CLUSTER_LAST) {
+      return Cluster;
+    }
+    //
+    // Claim the cluster in the bitmap right away, its FAT entry is only
+    // written once the caller links the next cluster or ends the chain
+    //
+    FatMarkCluster (Volume, Cluster, TRUE);
+    Volume->FatInfoSector.FreeInfo.NextCluster = (UINT32) (Cluster + 1);
+    return Cluster;
+  }
+
   for (;;) {
     //
     // If the end of the list, return no available cluster
@@ -316,6 +601,156 @@ FatAllocateCluster (
   return Cluster;
 }
 
+/**
+
+  Discard the extent map of the open file, after its cluster chain has been
+  shortened or replaced.
+
+  @param  OFile                 - The open file.
+
+**/
+STATIC
+VOID
+FatResetExtentMap (
+  IN FAT_OFILE            *OFile
+  )
+{
+  OFile->ExtentCount      = 0;
+  OFile->ExtentsComplete  = FALSE;
+}
+
+/**
+
+  Extend the extent map of the open file by following its cluster chain,
+  until the map covers the cluster of the file at ClusterIndex or reaches
+  the end of the chain.
+
+  @param  OFile                 - The open file.
+  @param  ClusterIndex          - The index of the cluster within the file.
+
+  @retval EFI_SUCCESS           - The map is extended successfully.
+  @retval EFI_OUT_OF_RESOURCES  - Can not allocate memory for the map.
+  @retval EFI_VOLUME_CORRUPTED  - Cluster chain corrupt.
+
+**/
+STATIC
+EFI_STATUS
+FatExtendExtentMap (
+  IN FAT_OFILE            *OFile,
+  IN UINTN                ClusterIndex
+  )
+{
+  FAT_VOLUME  *Volume;
+  FAT_EXTENT  *Extent;
+  FAT_EXTENT  *NewExtents;
+  UINTN       NewMax;
+  UINTN       Cluster;
+  UINTN       FileIndex;
+
+  Volume = OFile->Volume;
+
+  while (!OFile->ExtentsComplete) {
+    if (OFile->ExtentCount > 0) {
+      Extent = &OFile->Extents[OFile->ExtentCount - 1];
+      if (Extent->FileIndex + Extent->Count > ClusterIndex) {
+        break;
+      }
+
+      FileIndex = Extent->FileIndex + Extent->Count;
+      Cluster   = FatGetFatEntry (Volume, Extent->Cluster + Extent->Count - 1);
+      if (FAT_END_OF_FAT_CHAIN (Cluster)) {
+        OFile->ExtentsComplete = TRUE;
+        break;
+      }
+    } else {
+      Extent    = NULL;
+      FileIndex = 0;
+      Cluster   = OFile->FileCluster;
+      if (Cluster == FAT_CLUSTER_FREE) {
+        //
+        // The file has no cluster at all
+        //
+        OFile->ExtentsComplete = TRUE;
+        break;
+      }
+    }
+
+    if (Cluster < FAT_MIN_CLUSTER || Cluster >= FAT_CLUSTER_SPECIAL) {
+      DEBUG ((EFI_D_INIT | EFI_D_ERROR, "FatExtendExtentMap: cluster chain corrupt\n"));
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if (Extent != NULL && Cluster == Extent->Cluster + Extent->Count) {
+      Extent->Count += 1;
+      continue;
+    }
+    //
+    // Start a new run
+    //
+    if (OFile->ExtentCount == OFile->ExtentMax) {
+      NewMax      = MAX (OFile->ExtentMax * 2, FAT_EXTENT_MAP_MIN_SIZE);
+      NewExtents  = ReallocatePool (
+                      OFile->ExtentMax * sizeof (FAT_EXTENT),
+                      NewMax * sizeof (FAT_EXTENT),
+                      OFile->Extents
+                      );
+      if (NewExtents == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      OFile->Extents    = NewExtents;
+      OFile->ExtentMax  = NewMax;
+    }
+
+    Extent            = &OFile->Extents[OFile->ExtentCount++];
+    Extent->FileIndex = FileIndex;
+    Extent->Cluster   = Cluster;
+    Extent->Count     = 1;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+
+  Find the run in the extent map of the open file which holds the cluster
+  of the file at ClusterIndex.
+
+  @param  OFile                 - The open file.
+  @param  ClusterIndex          - The index of the cluster within the file.
+
+  @return The run holding the cluster, or NULL if the map does not cover it.
+
+**/
+STATIC
+FAT_EXTENT *
+FatFindExtent (
+  IN FAT_OFILE            *OFile,
+  IN UINTN                ClusterIndex
+  )
+{
+  UINTN       Low;
+  UINTN       High;
+  UINTN       Middle;
+  FAT_EXTENT  *Extent;
+
+  Low   = 0;
+  High  = OFile->ExtentCount;
+  while (Low < High) {
+    Middle = (Low + High) / 2;
+    Extent = &OFile->Extents[Middle];
+    if (ClusterIndex < Extent->FileIndex) {
+      High = Middle;
+    } else if (ClusterIndex >= Extent->FileIndex + Extent->Count) {
+      Low = Middle + 1;
+    } else {
+      return Extent;
+    }
+  }
+
+  return NULL;
+}
+
 /**
 
   Count the number of clusters given a size.
@@ -406,6 +841,7 @@ FatShrinkEof (
   // Set CurrentCluster == FileCluster
   // to force a recalculation of Position related stuffs
   //
+  FatResetExtentMap (OFile);
   OFile->FileCurrentCluster = OFile->FileCluster;
   OFile->FileLastCluster    = LastCluster;
   OFile->Dirty              = TRUE;
@@ -493,12 +929,19 @@ FatGrowEof (
 
     }
     //
+    // Build the free cluster bitmap on the first allocation, falling back to
+    // walking the FAT entries if it can not be built
+    //
+    if (Volume->FreeBitmap == NULL && !Volume->DiskError) {
+      FatBuildFreeBitmap (Volume);
+    }
+    //
     // Loop until we've allocated enough space
     //
     LastCluster = OFile->FileLastCluster;
 
     while (CurSize < NewSize) {
-      NewCluster = FatAllocateCluster (Volume);
+      NewCluster = FatAllocateCluster (Volume, LastCluster, NewSize - CurSize);
       if (FAT_END_OF_FAT_CHAIN (NewCluster)) {
         if (LastCluster != FAT_CLUSTER_FREE) {
           FatSetFatEntry (Volume, LastCluster, (UINTN) FAT_CLUSTER_LAST);
@@ -524,6 +967,10 @@ FatGrowEof (
     //
     FatSetFatEntry (Volume, LastCluster, (UINTN) FAT_CLUSTER_LAST);
     OFile->FileLastCluster = LastCluster;
+    //
+    // The extent map is still valid, but no longer reaches the end of the chain
+    //
+    OFile->ExtentsComplete = FALSE;
   }
 
   OFile->FileSize = (UINTN) NewSizeInBytes;
@@ -555,9 +1002,13 @@ FatOFilePosition (
   IN UINTN                PosLimit
   )
 {
+  EFI_STATUS  Status;
   FAT_VOLUME  *Volume;
+  FAT_EXTENT  *Extent;
   UINTN       ClusterSize;
   UINTN       Cluster;
+  UINTN       ClusterIndex;
+  UINTN       RunClusters;
   UINTN       StartPos;
   UINTN       Run;
 
@@ -573,8 +1024,44 @@ FatOFilePosition (
   if (OFile->IsFixedRootDir) {
     OFile->PosDisk  = Volume->RootPos + Position;
     Run             = OFile->FileSize - Position;
+    OFile->PosRem   = Run;
+    return EFI_SUCCESS;
+  }
+  //
+  // Look up the position in the file's extent map, extending the map to
+  // cover the whole range that may be accessed
+  //
+  ClusterIndex  = Position >> Volume->ClusterAlignment;
+  Status        = FatExtendExtentMap (OFile, (Position + PosLimit - 1) >> Volume->ClusterAlignment);
+  if (Status != EFI_OUT_OF_RESOURCES) {
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Extent = FatFindExtent (OFile, ClusterIndex);
+    if (Extent == NULL) {
+      DEBUG ((EFI_D_INIT | EFI_D_ERROR, "FatOFilePosition:"" cluster chain corrupt\n"));
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    StartPos                  = ClusterIndex << Volume->ClusterAlignment;
+    Cluster                   = Extent->Cluster + (ClusterIndex - Extent->FileIndex);
+    OFile->PosDisk            = Volume->FirstClusterPos +
+                                LShiftU64 (Cluster - FAT_MIN_CLUSTER, Volume->ClusterAlignment) +
+                                Position - StartPos;
+    OFile->FileCurrentCluster = Cluster;
+    OFile->Position           = StartPos;
+
+    //
+    // The run goes to the end of the extent, but there is no need to
+    // report more than PosLimit
+    //
+    RunClusters = Extent->FileIndex + Extent->Count - ClusterIndex;
+    RunClusters = MIN (RunClusters, ((Position - StartPos + PosLimit - 1) >> Volume->ClusterAlignment) + 1);
+    Run         = (RunClusters << Volume->ClusterAlignment) - (Position - StartPos);
   } else {
     //
+    // There is no memory for the extent map.
     // Run the file's cluster chain to find the current position
     // If possible, run from the current cluster rather than
     // start from beginning
@@ -712,9 +1199,13 @@ FatComputeFreeInfo (
   UINTN Index;
 
   //
-  // If we don't have valid info, compute it now
+  // If we don't have valid info, compute it now, preferably by building
+  // the free cluster bitmap
   //
   if (!Volume->FreeInfoValid) {
+    if (Volume->FreeBitmap == NULL && !EFI_ERROR (FatBuildFreeBitmap (Volume))) {
+      return;
+    }
 
     Volume->FreeInfoValid                        = TRUE;
     Volume->FatInfoSector.FreeInfo.ClusterCount  = 0;
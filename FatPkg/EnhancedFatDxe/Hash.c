@@ -39,7 +39,7 @@ FatHashLongName (
     );
   FatStrUpr (UpCasedLongFileName);
   gBS->CalculateCrc32 (UpCasedLongFileName, StrSize (UpCasedLongFileName), &HashValue);
-  return (HashValue & HASH_TABLE_MASK);
+  return HashValue;
 }
 
 /**
@@ -59,7 +59,67 @@ FatHashShortName (
 {
   UINT32  HashValue;
   gBS->CalculateCrc32 (ShortNameString, FAT_NAME_LEN, &HashValue);
-  return (HashValue & HASH_TABLE_MASK);
+  return HashValue;
+}
+
+/**
+
+  Double the size of the hash tables of the directory and rehash its entries.
+  If there is not enough memory, the current hash tables are kept.
+
+  @param  ODir                  - The directory whose hash tables are to be grown.
+
+**/
+STATIC
+VOID
+FatGrowHashTable (
+  IN FAT_ODIR     *ODir
+  )
+{
+  FAT_DIRENT  **LongNameHashTable;
+  FAT_DIRENT  **ShortNameHashTable;
+  FAT_DIRENT  *DirEnt;
+  FAT_DIRENT  *NextDirEnt;
+  UINTN       NewSize;
+  UINTN       Index;
+  UINT32      HashTableIndex;
+
+  NewSize             = ODir->HashTableSize * 2;
+  LongNameHashTable   = AllocateZeroPool (NewSize * sizeof (FAT_DIRENT *));
+  ShortNameHashTable  = AllocateZeroPool (NewSize * sizeof (FAT_DIRENT *));
+  if (LongNameHashTable == NULL || ShortNameHashTable == NULL) {
+    if (LongNameHashTable != NULL) {
+      FreePool (LongNameHashTable);
+    }
+
+    if (ShortNameHashTable != NULL) {
+      FreePool (ShortNameHashTable);
+    }
+
+    return;
+  }
+
+  for (Index = 0; Index < ODir->HashTableSize; Index++) {
+    for (DirEnt = ODir->ShortNameHashTable[Index]; DirEnt != NULL; DirEnt = NextDirEnt) {
+      NextDirEnt                          = DirEnt->ShortNameForwardLink;
+      HashTableIndex                      = FatHashShortName (DirEnt->Entry.FileName) & (UINT32) (NewSize - 1);
+      DirEnt->ShortNameForwardLink        = ShortNameHashTable[HashTableIndex];
+      ShortNameHashTable[HashTableIndex]  = DirEnt;
+    }
+
+    for (DirEnt = ODir->LongNameHashTable[Index]; DirEnt != NULL; DirEnt = NextDirEnt) {
+      NextDirEnt                          = DirEnt->LongNameForwardLink;
+      HashTableIndex                      = FatHashLongName (DirEnt->FileString) & (UINT32) (NewSize - 1);
+      DirEnt->LongNameForwardLink         = LongNameHashTable[HashTableIndex];
+      LongNameHashTable[HashTableIndex]   = DirEnt;
+    }
+  }
+
+  FreePool (ODir->LongNameHashTable);
+  FreePool (ODir->ShortNameHashTable);
+  ODir->LongNameHashTable   = LongNameHashTable;
+  ODir->ShortNameHashTable  = ShortNameHashTable;
+  ODir->HashTableSize       = NewSize;
 }
 
 /**
@@ -79,7 +139,7 @@ FatLongNameHashSearch (
   )
 {
   FAT_DIRENT  **PreviousHashNode;
-  for (PreviousHashNode   = &ODir->LongNameHashTable[FatHashLongName (LongNameString)];
+  for (PreviousHashNode   = &ODir->LongNameHashTable[FatHashLongName (LongNameString) & (ODir->HashTableSize - 1)];
        *PreviousHashNode != NULL;
        PreviousHashNode   = &(*PreviousHashNode)->LongNameForwardLink
       ) {
@@ -108,7 +168,7 @@ FatShortNameHashSearch (
   )
 {
   FAT_DIRENT  **PreviousHashNode;
-  for (PreviousHashNode   = &ODir->ShortNameHashTable[FatHashShortName (ShortNameString)];
+  for (PreviousHashNode   = &ODir->ShortNameHashTable[FatHashShortName (ShortNameString) & (ODir->HashTableSize - 1)];
        *PreviousHashNode != NULL;
        PreviousHashNode   = &(*PreviousHashNode)->ShortNameForwardLink
       ) {
@@ -137,20 +197,28 @@ FatInsertToHashTable (
   FAT_DIRENT  **HashTable;
   UINT32      HashTableIndex;
 
+  //
+  // Keep the hash chains short as the directory grows
+  //
+  if (ODir->DirEntCount >= ODir->HashTableSize * HASH_TABLE_LOAD_FACTOR &&
+      ODir->HashTableSize < HASH_TABLE_MAX_SIZE) {
+    FatGrowHashTable (ODir);
+  }
   //
   // Insert hash table index for short name
   //
-  HashTableIndex                = FatHashShortName (DirEnt->Entry.FileName);
+  HashTableIndex                = FatHashShortName (DirEnt->Entry.FileName) & (UINT32) (ODir->HashTableSize - 1);
   HashTable                     = ODir->ShortNameHashTable;
   DirEnt->ShortNameForwardLink  = HashTable[HashTableIndex];
   HashTable[HashTableIndex]     = DirEnt;
   //
   // Insert hash table index for long name
   //
-  HashTableIndex                = FatHashLongName (DirEnt->FileString);
+  HashTableIndex                = FatHashLongName (DirEnt->FileString) & (UINT32) (ODir->HashTableSize - 1);
   HashTable                     = ODir->LongNameHashTable;
   DirEnt->LongNameForwardLink   = HashTable[HashTableIndex];
   HashTable[HashTableIndex]     = DirEnt;
+  ODir->DirEntCount++;
 }
 
 /**
@@ -169,4 +237,5 @@ FatDeleteFromHashTable (
 {
   *FatShortNameHashSearch (ODir, DirEnt->Entry.FileName) = DirEnt->ShortNameForwardLink;
   *FatLongNameHashSearch (ODir, DirEnt->FileString)      = DirEnt->LongNameForwardLink;
+  ODir->DirEntCount--;
 }
@@ -462,6 +462,12 @@ FatFreeVolume (
     FreePool (Volume->CacheBuffer);
   }
   //
+  // Free the free cluster bitmap
+  //
+  if (Volume->FreeBitmap != NULL) {
+    FreePool (Volume->FreeBitmap);
+  }
+  //
   // Free directory cache
   //
   FatCleanupODirCache (Volume);
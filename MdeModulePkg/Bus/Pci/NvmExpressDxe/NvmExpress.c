@@ -654,15 +654,8 @@ ProcessAsyncTaskList (
         if (AsyncRequest->MapMeta != NULL) {
           PciIo->Unmap (PciIo, AsyncRequest->MapMeta);
         }
-        if (AsyncRequest->MapPrpList != NULL) {
-          PciIo->Unmap (PciIo, AsyncRequest->MapPrpList);
-        }
-        if (AsyncRequest->PrpListHost != NULL) {
-          PciIo->FreeBuffer (
-                   PciIo,
-                   AsyncRequest->PrpListNo,
-                   AsyncRequest->PrpListHost
-                   );
+        if (AsyncRequest->PrpList != NULL) {
+          NvmeReleasePrpList (Private, AsyncRequest->PrpList);
         }
 
         RemoveEntryList (Link);
@@ -1008,6 +1001,7 @@ NvmExpressDriverBindingStart (
     CopyMem (&Private->PassThruMode, &gEfiNvmExpressPassThruMode, sizeof (EFI_NVM_EXPRESS_PASS_THRU_MODE));
     InitializeListHead (&Private->AsyncPassThruQueue);
     InitializeListHead (&Private->UnsubmittedSubtasks);
+    InitializeListHead (&Private->PrpListPool);
 
     Status = NvmeControllerInit (Private);
     if (EFI_ERROR(Status)) {
@@ -1101,6 +1095,7 @@ Exit:
   }
 
   if ((Private != NULL) && (Private->ControllerData != NULL)) {
+    NvmeDestroyPrpListPool (Private);
     FreePool (Private->ControllerData);
   }
 
@@ -1223,6 +1218,7 @@ NvmExpressDriverBindingStop (
         Private->PciIo->FreeBuffer (Private->PciIo, 6, Private->Buffer);
       }
 
+      NvmeDestroyPrpListPool (Private);
       FreePool (Private->ControllerData);
       FreePool (Private);
     }
@@ -156,6 +156,13 @@ struct _NVME_CONTROLLER_PRIVATE_DATA {
 
   VOID                                *Mapping;
 
+  //
+  // PRP list buffers that are mapped once and reused by later commands.
+  // PrpListPages is the size of each pooled buffer.
+  //
+  LIST_ENTRY                          PrpListPool;
+  UINTN                               PrpListPages;
+
   //
   // For Non-blocking operations.
   //
@@ -281,6 +288,42 @@ typedef struct {
 #define NVME_BLKIO2_SUBTASK_FROM_LINK(a) \
   CR (a, NVME_BLKIO2_SUBTASK, Link, NVME_BLKIO2_SUBTASK_SIGNATURE)
 
+//
+// PRP list buffer, allocated and mapped for bus master common buffer access.
+//
+#define NVME_PRP_LIST_SIGNATURE            SIGNATURE_32 ('N', 'P', 'R', 'L')
+
+typedef struct {
+  UINT32                                   Signature;
+  LIST_ENTRY                               Link;
+
+  UINTN                                    Pages;
+  VOID                                     *HostAddr;
+  EFI_PHYSICAL_ADDRESS                     PciAddr;
+  VOID                                     *Mapping;
+} NVME_PRP_LIST;
+
+#define NVME_PRP_LIST_FROM_LINK(a) \
+  CR (a, NVME_PRP_LIST, Link, NVME_PRP_LIST_SIGNATURE)
+
+//
+// Values of the PRP or SGL for Data Transfer (PSDT) field of a command.
+//
+#define NVME_PSDT_PRP                      0
+#define NVME_PSDT_SGL_MPTR_CONTIGUOUS      1
+
+//
+// SGL Data Block descriptor, placed in the data pointer of a command.
+//
+typedef struct {
+  UINT64                                   Address;
+  UINT32                                   Length;
+  UINT8                                    Rsvd[3];
+  UINT8                                    Id;        // Descriptor type in bits 7:4
+} NVME_SGL_DESC;
+
+#define NVME_SGL_DATA_BLOCK_DESC           0x00
+
 //
 // Nvme asynchronous passthru request.
 //
@@ -292,9 +335,7 @@ typedef struct {
 
   EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET *Packet;
   UINT16                                   CommandId;
-  VOID                                     *MapPrpList;
-  UINTN                                    PrpListNo;
-  VOID                                     *PrpListHost;
+  NVME_PRP_LIST                            *PrpList;
   VOID                                     *MapData;
   VOID                                     *MapMeta;
   EFI_EVENT                                CallerEvent;
@@ -721,4 +762,44 @@ NvmeDumpStatus (
   IN NVME_CQ             *Cq
   );
 
+/**
+  Return a PRP list buffer to the controller's pool, or free it if it does
+  not have the pooled size.
+
+  @param[in]     Private          The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param[in]     PrpList          The PRP list buffer to release.
+
+**/
+VOID
+NvmeReleasePrpList (
+  IN NVME_CONTROLLER_PRIVATE_DATA     *Private,
+  IN NVME_PRP_LIST                    *PrpList
+  );
+
+/**
+  Unmap and free all the PRP list buffers in the controller's pool.
+
+  @param[in]     Private          The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+
+**/
+VOID
+NvmeDestroyPrpListPool (
+  IN NVME_CONTROLLER_PRIVATE_DATA     *Private
+  );
+
+/**
+  Call back function when the timer event is signaled.
+
+  @param[in]  Event     The Event this notify function registered to.
+  @param[in]  Context   Pointer to the context data registered to the
+                        Event.
+
+**/
+VOID
+EFIAPI
+ProcessAsyncTaskList (
+  IN EFI_EVENT                    Event,
+  IN VOID*                        Context
+  );
+
 #endif
@@ -201,6 +201,16 @@ NvmeRead (
     MaxTransferBlocks = 1024;
   }
 
+  //
+  // Keep all the chunks of a large request in flight at once instead of
+  // waiting for each of them in turn on the synchronous I/O queue.
+  //
+  if (Blocks > MaxTransferBlocks) {
+    Status = NvmeQueuedTransfer (Device, Buffer, Lba, Blocks, TRUE);
+    Blocks = EFI_ERROR (Status) ? Blocks : 0;
+    goto Done;
+  }
+
   while (Blocks > 0) {
     if (Blocks > MaxTransferBlocks) {
       Status = ReadSectors (Device, (UINT64)(UINTN)Buffer, Lba, MaxTransferBlocks);
@@ -218,6 +228,7 @@ NvmeRead (
     }
   }
 
+Done:
   DEBUG ((EFI_D_VERBOSE, "%a: Lba = 0x%08Lx, Original = 0x%08Lx, "
     "Remaining = 0x%08Lx, BlockSize = 0x%x, Status = %r\n", __FUNCTION__, Lba,
     (UINT64)OrginalBlocks, (UINT64)Blocks, BlockSize, Status));
@@ -279,6 +290,16 @@ NvmeWrite (
     MaxTransferBlocks = 1024;
   }
 
+  //
+  // Keep all the chunks of a large request in flight at once instead of
+  // waiting for each of them in turn on the synchronous I/O queue.
+  //
+  if (Blocks > MaxTransferBlocks) {
+    Status = NvmeQueuedTransfer (Device, Buffer, Lba, Blocks, FALSE);
+    Blocks = EFI_ERROR (Status) ? Blocks : 0;
+    goto Done;
+  }
+
   while (Blocks > 0) {
     if (Blocks > MaxTransferBlocks) {
       Status = WriteSectors (Device, (UINT64)(UINTN)Buffer, Lba, MaxTransferBlocks);
@@ -296,6 +317,7 @@ NvmeWrite (
     }
   }
 
+Done:
   DEBUG ((EFI_D_VERBOSE, "%a: Lba = 0x%08Lx, Original = 0x%08Lx, "
     "Remaining = 0x%08Lx, BlockSize = 0x%x, Status = %r\n", __FUNCTION__, Lba,
     (UINT64)OrginalBlocks, (UINT64)Blocks, BlockSize, Status));
@@ -929,6 +951,279 @@ NvmeAsyncWrite (
   return Status;
 }
 
+/**
+  Abort a request queued by NvmeQueuedTransfer() that did not complete in time.
+
+  The chunks already submitted may still be transferring data to or from the
+  caller's buffer, so the controller is reset first. Every command left on the
+  asynchronous submission queue is then completed with an "aborted due to SQ
+  deletion" status, which fails the BlockIo2 requests they belong to. The
+  chunks of Token's request not submitted yet are removed. On return no DMA
+  targets the caller's buffer any more and, once the notification functions
+  of the aborted subtasks have run, the request is off the device queue and
+  Token is signalled.
+
+  This function must be called at TPL_NOTIFY.
+
+  @param  Device                 The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+  @param  Token                  The token of the request to abort.
+
+**/
+VOID
+NvmeAbortQueuedTransfer (
+  IN NVME_DEVICE_PRIVATE_DATA           *Device,
+  IN EFI_BLOCK_IO2_TOKEN                *Token
+  )
+{
+  EFI_STATUS                       Status;
+  NVME_CONTROLLER_PRIVATE_DATA     *Private;
+  EFI_PCI_IO_PROTOCOL              *PciIo;
+  LIST_ENTRY                       *Link;
+  LIST_ENTRY                       *NextLink;
+  NVME_PASS_THRU_ASYNC_REQ         *AsyncRequest;
+  NVME_BLKIO2_SUBTASK              *Subtask;
+  NVME_BLKIO2_REQUEST              *BlkIo2Request;
+  NVME_CQ                          *Completion;
+
+  Private = Device->Controller;
+  PciIo   = Private->PciIo;
+
+  //
+  // Disabling the controller aborts all the outstanding commands. If it can
+  // not be brought back, stop it from mastering the bus so none of them can
+  // still access memory.
+  //
+  Status = NvmeControllerInit (Private);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((EFI_D_ERROR, "%a: controller reset failed - %r\n", __FUNCTION__, Status));
+    PciIo->Attributes (
+             PciIo,
+             EfiPciIoAttributeOperationDisable,
+             EFI_PCI_IO_ATTRIBUTE_BUS_MASTER,
+             NULL
+             );
+  }
+
+  //
+  // Complete the commands the reset discarded.
+  //
+  for (Link = GetFirstNode (&Private->AsyncPassThruQueue);
+       !IsNull (&Private->AsyncPassThruQueue, Link);
+       Link = NextLink) {
+    NextLink     = GetNextNode (&Private->AsyncPassThruQueue, Link);
+    AsyncRequest = NVME_PASS_THRU_ASYNC_REQ_FROM_THIS (Link);
+
+    Completion = (NVME_CQ *) AsyncRequest->Packet->NvmeCompletion;
+    ZeroMem (Completion, sizeof (EFI_NVM_EXPRESS_COMPLETION));
+    Completion->Sct = 0x0;
+    Completion->Sc  = 0x8;
+
+    if (AsyncRequest->MapData != NULL) {
+      PciIo->Unmap (PciIo, AsyncRequest->MapData);
+    }
+    if (AsyncRequest->MapMeta != NULL) {
+      PciIo->Unmap (PciIo, AsyncRequest->MapMeta);
+    }
+    if (AsyncRequest->PrpList != NULL) {
+      NvmeReleasePrpList (Private, AsyncRequest->PrpList);
+    }
+
+    RemoveEntryList (Link);
+    gBS->SignalEvent (AsyncRequest->CallerEvent);
+    FreePool (AsyncRequest);
+  }
+
+  //
+  // Find the BlockIo2 request of Token. It is gone if its last subtask
+  // completed in the meantime.
+  //
+  for (Link = GetFirstNode (&Device->AsyncQueue);
+       !IsNull (&Device->AsyncQueue, Link);
+       Link = GetNextNode (&Device->AsyncQueue, Link)) {
+    BlkIo2Request = NVME_BLKIO2_REQUEST_FROM_LINK (Link);
+    if (BlkIo2Request->Token == Token) {
+      break;
+    }
+  }
+
+  if (IsNull (&Device->AsyncQueue, Link)) {
+    return;
+  }
+
+  Token->TransactionStatus = EFI_DEVICE_ERROR;
+
+  //
+  // Drop the subtasks of the request that were never submitted.
+  //
+  for (Link = GetFirstNode (&Private->UnsubmittedSubtasks);
+       !IsNull (&Private->UnsubmittedSubtasks, Link);
+       Link = NextLink) {
+    NextLink = GetNextNode (&Private->UnsubmittedSubtasks, Link);
+    Subtask  = NVME_BLKIO2_SUBTASK_FROM_LINK (Link);
+    if (Subtask->BlockIo2Request != BlkIo2Request) {
+      continue;
+    }
+
+    RemoveEntryList (Link);
+    gBS->CloseEvent (Subtask->Event);
+    FreePool (Subtask->CommandPacket->NvmeCmd);
+    FreePool (Subtask->CommandPacket->NvmeCompletion);
+    FreePool (Subtask->CommandPacket);
+    FreePool (Subtask);
+  }
+
+  BlkIo2Request->UnsubmittedSubtaskNum = 0;
+  BlkIo2Request->LastSubtaskSubmitted  = TRUE;
+
+  //
+  // With no subtask left in flight, nothing else will complete the request.
+  // Otherwise the notification function of its last aborted subtask does.
+  //
+  if (IsListEmpty (&BlkIo2Request->SubtasksQueue)) {
+    RemoveEntryList (&BlkIo2Request->Link);
+    FreePool (BlkIo2Request);
+    gBS->SignalEvent (Token->Event);
+  }
+}
+
+/**
+  Read or write a request that spans several MDTS sized chunks through the
+  asynchronous I/O queue and wait for all of them to complete.
+
+  The chunks are queued as BlockIo2 subtasks. Instead of waiting for the
+  asynchronous timer to submit and reap them, the queue is serviced from
+  the caller's context so the controller always has the remaining chunks
+  to work on.
+
+  @param  Device                 The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+  @param  Buffer                 The buffer used to store the data read from, or
+                                 to be written to, the device.
+  @param  Lba                    The start block number.
+  @param  Blocks                 Total block number to be transferred.
+  @param  IsRead                 TRUE to read from the device, FALSE to write.
+
+  @retval EFI_SUCCESS            All the blocks were transferred.
+  @retval EFI_TIMEOUT            The request did not complete in time. The
+                                 controller was reset and no chunk of the
+                                 request accesses Buffer any more.
+  @retval Others                 Fail to transfer all the blocks.
+
+**/
+EFI_STATUS
+NvmeQueuedTransfer (
+  IN     NVME_DEVICE_PRIVATE_DATA       *Device,
+  IN OUT VOID                           *Buffer,
+  IN     UINT64                         Lba,
+  IN     UINTN                          Blocks,
+  IN     BOOLEAN                        IsRead
+  )
+{
+  EFI_STATUS                       Status;
+  NVME_CONTROLLER_PRIVATE_DATA     *Private;
+  EFI_BLOCK_IO2_TOKEN              *Token;
+  EFI_EVENT                        TimerEvent;
+  EFI_TPL                          OldTpl;
+  UINT32                           MaxTransferBlocks;
+  BOOLEAN                          InFlight;
+
+  Private    = Device->Controller;
+  TimerEvent = NULL;
+  InFlight   = FALSE;
+
+  if (Private->ControllerData->Mdts != 0) {
+    MaxTransferBlocks = (1 << (Private->ControllerData->Mdts)) * (1 << (Private->Cap.Mpsmin + 12)) / Device->Media.BlockSize;
+  } else {
+    MaxTransferBlocks = 1024;
+  }
+
+  Token = AllocateZeroPool (sizeof (EFI_BLOCK_IO2_TOKEN));
+  if (Token == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // The token event is only polled, so it needs no notification function.
+  //
+  Status = gBS->CreateEvent (0, 0, NULL, NULL, &Token->Event);
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  Status = gBS->CreateEvent (EVT_TIMER, TPL_CALLBACK, NULL, NULL, &TimerEvent);
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  //
+  // Allow each chunk the timeout a single synchronous command would get.
+  //
+  Status = gBS->SetTimer (
+                  TimerEvent,
+                  TimerRelative,
+                  MultU64x32 (NVME_GENERIC_TIMEOUT, (UINT32) (Blocks / MaxTransferBlocks) + 1)
+                  );
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  Token->TransactionStatus = EFI_SUCCESS;
+  if (IsRead) {
+    Status = NvmeAsyncRead (Device, Buffer, Lba, Blocks, Token);
+  } else {
+    Status = NvmeAsyncWrite (Device, Buffer, Lba, Blocks, Token);
+  }
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  InFlight = TRUE;
+  Status   = EFI_TIMEOUT;
+  while (EFI_ERROR (gBS->CheckEvent (TimerEvent))) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    ProcessAsyncTaskList (NULL, Private);
+    gBS->RestoreTPL (OldTpl);
+
+    if (!EFI_ERROR (gBS->CheckEvent (Token->Event))) {
+      InFlight = FALSE;
+      Status   = Token->TransactionStatus;
+      break;
+    }
+  }
+
+  if (InFlight) {
+    //
+    // The caller frees or reuses Buffer as soon as this function returns, so
+    // stop every chunk of the request before returning. The notification
+    // functions of the aborted subtasks run when the TPL is restored and
+    // signal the token.
+    //
+    DEBUG ((EFI_D_ERROR, "%a: Lba = 0x%08Lx, Blocks = 0x%x timed out, reset the controller\n", __FUNCTION__, Lba, Blocks));
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    NvmeAbortQueuedTransfer (Device, Token);
+    gBS->RestoreTPL (OldTpl);
+
+    InFlight = EFI_ERROR (gBS->CheckEvent (Token->Event));
+  }
+
+Exit:
+  if (TimerEvent != NULL) {
+    gBS->CloseEvent (TimerEvent);
+  }
+
+  //
+  // If the token was not signalled, a subtask still references it, so it has
+  // to stay allocated.
+  //
+  if (!InFlight) {
+    if (Token->Event != NULL) {
+      gBS->CloseEvent (Token->Event);
+    }
+    FreePool (Token);
+  }
+
+  return Status;
+}
+
 /**
   Reset the Block Device.
 
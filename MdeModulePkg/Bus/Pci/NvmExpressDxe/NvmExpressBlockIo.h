@@ -414,4 +414,55 @@ NvmeStorageSecuritySendData (
   IN VOID                                     *PayloadBuffer
   );
 
+/**
+  Abort a request queued by NvmeQueuedTransfer() that did not complete in time.
+
+  The chunks already submitted may still be transferring data to or from the
+  caller's buffer, so the controller is reset first. Every command left on the
+  asynchronous submission queue is then completed with an "aborted due to SQ
+  deletion" status, which fails the BlockIo2 requests they belong to. The
+  chunks of Token's request not submitted yet are removed. On return no DMA
+  targets the caller's buffer any more and, once the notification functions
+  of the aborted subtasks have run, the request is off the device queue and
+  Token is signalled.
+
+  This function must be called at TPL_NOTIFY.
+
+  @param  Device                 The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+  @param  Token                  The token of the request to abort.
+
+**/
+VOID
+NvmeAbortQueuedTransfer (
+  IN NVME_DEVICE_PRIVATE_DATA           *Device,
+  IN EFI_BLOCK_IO2_TOKEN                *Token
+  );
+
+/**
+  Read or write a request that spans several MDTS sized chunks through the
+  asynchronous I/O queue and wait for all of them to complete.
+
+  @param  Device                 The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+  @param  Buffer                 The buffer used to store the data read from, or
+                                 to be written to, the device.
+  @param  Lba                    The start block number.
+  @param  Blocks                 Total block number to be transferred.
+  @param  IsRead                 TRUE to read from the device, FALSE to write.
+
+  @retval EFI_SUCCESS            All the blocks were transferred.
+  @retval EFI_TIMEOUT            The request did not complete in time. The
+                                 controller was reset and no chunk of the
+                                 request accesses Buffer any more.
+  @retval Others                 Fail to transfer all the blocks.
+
+**/
+EFI_STATUS
+NvmeQueuedTransfer (
+  IN     NVME_DEVICE_PRIVATE_DATA       *Device,
+  IN OUT VOID                           *Buffer,
+  IN     UINT64                         Lba,
+  IN     UINTN                          Blocks,
+  IN     BOOLEAN                        IsRead
+  );
+
 #endif
@@ -199,37 +199,209 @@ NvmeDumpStatus (
 }
 
 /**
-  Create PRP lists for data transfer which is larger than 2 memory pages.
-  Note here we calcuate the number of required PRP lists and allocate them at one time.
+  Unmap and free a PRP list buffer.
 
   @param[in]     PciIo               A pointer to the EFI_PCI_IO_PROTOCOL instance.
+  @param[in]     PrpList             The PRP list buffer to free.
+
+**/
+VOID
+NvmeFreePrpList (
+  IN EFI_PCI_IO_PROTOCOL              *PciIo,
+  IN NVME_PRP_LIST                    *PrpList
+  )
+{
+  if (PrpList->Mapping != NULL) {
+    PciIo->Unmap (PciIo, PrpList->Mapping);
+  }
+
+  if (PrpList->HostAddr != NULL) {
+    PciIo->FreeBuffer (PciIo, PrpList->Pages, PrpList->HostAddr);
+  }
+
+  FreePool (PrpList);
+}
+
+/**
+  Get a PRP list buffer of at least the given number of pages.
+
+  Buffers large enough for a maximum sized transfer are taken from the
+  controller's pool, so the common case needs neither an allocation nor a
+  PciIo mapping per command. Larger requests, which only happen when the
+  controller reports no MDTS limit, get a dedicated buffer.
+
+  @param[in]     Private             The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param[in]     Pages               The number of PRP list pages needed.
+
+  @retval The PRP list buffer, or NULL if it could not be allocated.
+
+**/
+NVME_PRP_LIST *
+NvmeAcquirePrpList (
+  IN NVME_CONTROLLER_PRIVATE_DATA     *Private,
+  IN UINTN                            Pages
+  )
+{
+  EFI_PCI_IO_PROTOCOL         *PciIo;
+  NVME_PRP_LIST               *PrpList;
+  LIST_ENTRY                  *Link;
+  UINTN                       Bytes;
+  UINT32                      MaxTransLen;
+  EFI_TPL                     OldTpl;
+  EFI_STATUS                  Status;
+
+  PciIo = Private->PciIo;
+
+  if (Private->PrpListPages == 0) {
+    //
+    // Size the pooled buffers for the largest transfer the controller
+    // accepts. A page of PRP entries chains to the next page through its
+    // last entry, and the first data page is described by PRP1.
+    //
+    if (Private->ControllerData->Mdts != 0) {
+      MaxTransLen = (1 << (Private->ControllerData->Mdts)) *
+                    (1 << (Private->Cap.Mpsmin + 12));
+      Private->PrpListPages = (EFI_SIZE_TO_PAGES (MaxTransLen) + (EFI_PAGE_SIZE / sizeof (UINT64)) - 2) /
+                              ((EFI_PAGE_SIZE / sizeof (UINT64)) - 1);
+    }
+
+    if (Private->PrpListPages == 0) {
+      Private->PrpListPages = 1;
+    }
+  }
+
+  if (Pages <= Private->PrpListPages) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    if (!IsListEmpty (&Private->PrpListPool)) {
+      Link = GetFirstNode (&Private->PrpListPool);
+      RemoveEntryList (Link);
+      gBS->RestoreTPL (OldTpl);
+      return NVME_PRP_LIST_FROM_LINK (Link);
+    }
+    gBS->RestoreTPL (OldTpl);
+
+    Pages = Private->PrpListPages;
+  }
+
+  PrpList = AllocateZeroPool (sizeof (NVME_PRP_LIST));
+  if (PrpList == NULL) {
+    return NULL;
+  }
+
+  PrpList->Signature = NVME_PRP_LIST_SIGNATURE;
+  PrpList->Pages     = Pages;
+
+  Status = PciIo->AllocateBuffer (
+                    PciIo,
+                    AllocateAnyPages,
+                    EfiBootServicesData,
+                    Pages,
+                    &PrpList->HostAddr,
+                    0
+                    );
+  if (EFI_ERROR (Status)) {
+    PrpList->HostAddr = NULL;
+    goto EXIT;
+  }
+
+  Bytes = EFI_PAGES_TO_SIZE (Pages);
+  Status = PciIo->Map (
+                    PciIo,
+                    EfiPciIoOperationBusMasterCommonBuffer,
+                    PrpList->HostAddr,
+                    &Bytes,
+                    &PrpList->PciAddr,
+                    &PrpList->Mapping
+                    );
+  if (EFI_ERROR (Status) || (Bytes != EFI_PAGES_TO_SIZE (Pages))) {
+    DEBUG ((EFI_D_ERROR, "NvmeAcquirePrpList: create PrpList failure!\n"));
+    if (EFI_ERROR (Status)) {
+      PrpList->Mapping = NULL;
+    }
+    goto EXIT;
+  }
+
+  return PrpList;
+
+EXIT:
+  NvmeFreePrpList (PciIo, PrpList);
+  return NULL;
+}
+
+/**
+  Return a PRP list buffer to the controller's pool, or free it if it does
+  not have the pooled size.
+
+  @param[in]     Private          The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param[in]     PrpList          The PRP list buffer to release.
+
+**/
+VOID
+NvmeReleasePrpList (
+  IN NVME_CONTROLLER_PRIVATE_DATA     *Private,
+  IN NVME_PRP_LIST                    *PrpList
+  )
+{
+  EFI_TPL                     OldTpl;
+
+  if (PrpList->Pages != Private->PrpListPages) {
+    NvmeFreePrpList (Private->PciIo, PrpList);
+    return;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  InsertHeadList (&Private->PrpListPool, &PrpList->Link);
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  Unmap and free all the PRP list buffers in the controller's pool.
+
+  @param[in]     Private          The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+
+**/
+VOID
+NvmeDestroyPrpListPool (
+  IN NVME_CONTROLLER_PRIVATE_DATA     *Private
+  )
+{
+  LIST_ENTRY                  *Link;
+
+  while (!IsListEmpty (&Private->PrpListPool)) {
+    Link = GetFirstNode (&Private->PrpListPool);
+    RemoveEntryList (Link);
+    NvmeFreePrpList (Private->PciIo, NVME_PRP_LIST_FROM_LINK (Link));
+  }
+}
+
+/**
+  Create PRP lists for data transfer which is larger than 2 memory pages.
+  Note here we calcuate the number of required PRP lists and take them from
+  the PRP list pool at one time.
+
+  @param[in]     Private             The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
   @param[in]     PhysicalAddr        The physical base address of data buffer.
   @param[in]     Pages               The number of pages to be transfered.
-  @param[out]    PrpListHost         The host base address of PRP lists.
-  @param[in,out] PrpListNo           The number of PRP List.
-  @param[out]    Mapping             The mapping value returned from PciIo.Map().
+  @param[out]    PrpList             The PRP list buffer holding the PRP lists.
 
   @retval The pointer to the first PRP List of the PRP lists.
 
 **/
 VOID*
 NvmeCreatePrpList (
-  IN     EFI_PCI_IO_PROTOCOL          *PciIo,
+  IN     NVME_CONTROLLER_PRIVATE_DATA *Private,
   IN     EFI_PHYSICAL_ADDRESS         PhysicalAddr,
   IN     UINTN                        Pages,
-     OUT VOID                         **PrpListHost,
-  IN OUT UINTN                        *PrpListNo,
-     OUT VOID                         **Mapping
+     OUT NVME_PRP_LIST                **PrpList
   )
 {
   UINTN                       PrpEntryNo;
   UINT64                      PrpListBase;
+  UINTN                       PrpListNo;
   UINTN                       PrpListIndex;
   UINTN                       PrpEntryIndex;
   UINT64                      Remainder;
   EFI_PHYSICAL_ADDRESS        PrpListPhyAddr;
-  UINTN                       Bytes;
-  EFI_STATUS                  Status;
 
   //
   // The number of Prp Entry in a memory page.
@@ -239,50 +411,30 @@ NvmeCreatePrpList (
   //
   // Calculate total PrpList number.
   //
-  *PrpListNo = (UINTN)DivU64x64Remainder ((UINT64)Pages, (UINT64)PrpEntryNo - 1, &Remainder);
-  if (*PrpListNo == 0) {
-    *PrpListNo = 1;
+  PrpListNo = (UINTN)DivU64x64Remainder ((UINT64)Pages, (UINT64)PrpEntryNo - 1, &Remainder);
+  if (PrpListNo == 0) {
+    PrpListNo = 1;
   } else if ((Remainder != 0) && (Remainder != 1)) {
-    *PrpListNo += 1;
+    PrpListNo += 1;
   } else if (Remainder == 1) {
     Remainder = PrpEntryNo;
   } else if (Remainder == 0) {
     Remainder = PrpEntryNo - 1;
   }
 
-  Status = PciIo->AllocateBuffer (
-                    PciIo,
-                    AllocateAnyPages,
-                    EfiBootServicesData,
-                    *PrpListNo,
-                    PrpListHost,
-                    0
-                    );
-
-  if (EFI_ERROR (Status)) {
+  *PrpList = NvmeAcquirePrpList (Private, PrpListNo);
+  if (*PrpList == NULL) {
     return NULL;
   }
 
-  Bytes = EFI_PAGES_TO_SIZE (*PrpListNo);
-  Status = PciIo->Map (
-                    PciIo,
-                    EfiPciIoOperationBusMasterCommonBuffer,
-                    *PrpListHost,
-                    &Bytes,
-                    &PrpListPhyAddr,
-                    Mapping
-                    );
+  PrpListPhyAddr = (*PrpList)->PciAddr;
 
-  if (EFI_ERROR (Status) || (Bytes != EFI_PAGES_TO_SIZE (*PrpListNo))) {
-    DEBUG ((EFI_D_ERROR, "NvmeCreatePrpList: create PrpList failure!\n"));
-    goto EXIT;
-  }
   //
   // Fill all PRP lists except of last one.
   //
-  ZeroMem (*PrpListHost, Bytes);
-  for (PrpListIndex = 0; PrpListIndex < *PrpListNo - 1; ++PrpListIndex) {
-    PrpListBase = *(UINT64*)PrpListHost + PrpListIndex * EFI_PAGE_SIZE;
+  ZeroMem ((*PrpList)->HostAddr, EFI_PAGES_TO_SIZE (PrpListNo));
+  for (PrpListIndex = 0; PrpListIndex < PrpListNo - 1; ++PrpListIndex) {
+    PrpListBase = (UINTN)(*PrpList)->HostAddr + PrpListIndex * EFI_PAGE_SIZE;
 
     for (PrpEntryIndex = 0; PrpEntryIndex < PrpEntryNo; ++PrpEntryIndex) {
       if (PrpEntryIndex != PrpEntryNo - 1) {
@@ -302,17 +454,51 @@ NvmeCreatePrpList (
   //
   // Fill last PRP list.
   //
-  PrpListBase = *(UINT64*)PrpListHost + PrpListIndex * EFI_PAGE_SIZE;
+  PrpListBase = (UINTN)(*PrpList)->HostAddr + PrpListIndex * EFI_PAGE_SIZE;
   for (PrpEntryIndex = 0; PrpEntryIndex < Remainder; ++PrpEntryIndex) {
     *((UINT64*)(UINTN)PrpListBase + PrpEntryIndex) = PhysicalAddr;
     PhysicalAddr += EFI_PAGE_SIZE;
   }
 
   return (VOID*)(UINTN)PrpListPhyAddr;
+}
 
-EXIT:
-  PciIo->FreeBuffer (PciIo, *PrpListNo, *PrpListHost);
-  return NULL;
+/**
+  Check whether a data buffer can be described by a single SGL Data Block
+  descriptor instead of PRP entries.
+
+  SGLs are only used for I/O commands, and only if the SGL Support field
+  of the Identify Controller data is 01b (no alignment requirement) or 10b
+  (address and length must be dword aligned). The reserved value 11b is
+  treated as no SGL support. Controllers that require dword alignment get
+  PRPs for buffers that do not meet it.
+
+  @param[in]     Private             The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param[in]     PhysicalAddr        The device address of the mapped data buffer.
+  @param[in]     Length              The length of the data buffer in bytes.
+
+  @retval TRUE   An SGL Data Block descriptor can be used.
+  @retval FALSE  PRP entries must be used.
+
+**/
+BOOLEAN
+NvmeSglUsable (
+  IN NVME_CONTROLLER_PRIVATE_DATA     *Private,
+  IN EFI_PHYSICAL_ADDRESS             PhysicalAddr,
+  IN UINT32                           Length
+  )
+{
+  UINT32                      Sgls;
+
+  Sgls = Private->ControllerData->Sgls & (BIT0 | BIT1);
+  switch (Sgls) {
+    case BIT0:
+      return TRUE;
+    case BIT1:
+      return (BOOLEAN) (((PhysicalAddr | Length) & 0x3) == 0);
+    default:
+      return FALSE;
+  }
 }
 
 
@@ -370,11 +556,10 @@ NvmExpressPassThru (
   EFI_PHYSICAL_ADDRESS           PhyAddr;
   VOID                           *MapData;
   VOID                           *MapMeta;
-  VOID                           *MapPrpList;
   UINTN                          MapLength;
   UINT64                         *Prp;
-  VOID                           *PrpListHost;
-  UINTN                          PrpListNo;
+  NVME_PRP_LIST                  *PrpList;
+  NVME_SGL_DESC                  *Sgl;
   UINT32                         Attributes;
   UINT32                         IoAlign;
   UINT32                         MaxTransLen;
@@ -445,9 +630,7 @@ NvmExpressPassThru (
   PciIo       = Private->PciIo;
   MapData     = NULL;
   MapMeta     = NULL;
-  MapPrpList  = NULL;
-  PrpListHost = NULL;
-  PrpListNo   = 0;
+  PrpList     = NULL;
   Prp         = NULL;
   TimerEvent  = NULL;
   Status      = EFI_SUCCESS;
@@ -482,15 +665,6 @@ NvmExpressPassThru (
   Sq->Cid  = Private->Cid[QueueId]++;
   Sq->Nsid = Packet->NvmeCmd->Nsid;
 
-  //
-  // Currently we only support PRP for data transfer, SGL is NOT supported.
-  //
-  ASSERT (Sq->Psdt == 0);
-  if (Sq->Psdt != 0) {
-    DEBUG ((EFI_D_ERROR, "NvmExpressPassThru: doesn't support SGL mechanism\n"));
-    return EFI_UNSUPPORTED;
-  }
-
   Sq->Prp[0] = (UINT64)(UINTN)Packet->TransferBuffer;
   //
   // If the NVMe cmd has data in or out, then mapping the user buffer to the PCI controller specific addresses.
@@ -546,20 +720,30 @@ NvmExpressPassThru (
       Sq->Mptr = PhyAddr;
     }
   }
-  //
-  // If the buffer size spans more than two memory pages (page size as defined in CC.Mps),
-  // then build a PRP list in the second PRP submission queue entry.
-  //
   Offset = ((UINT16)Sq->Prp[0]) & (EFI_PAGE_SIZE - 1);
   Bytes  = Packet->TransferLength;
 
-  if ((Offset + Bytes) > (EFI_PAGE_SIZE * 2)) {
+  if ((MapData != NULL) && (QueueId != 0) && NvmeSglUsable (Private, Sq->Prp[0], Bytes)) {
+    //
+    // PciIo->Map() returned one contiguous device address range, so a
+    // single SGL Data Block descriptor describes the whole buffer and no
+    // PRP list is needed regardless of the transfer size.
     //
-    // Create PrpList for remaining data buffer.
+    Sgl          = (NVME_SGL_DESC *)&Sq->Prp[0];
+    Sgl->Address = Sq->Prp[0];
+    Sgl->Length  = Bytes;
+    ZeroMem (Sgl->Rsvd, sizeof (Sgl->Rsvd));
+    Sgl->Id      = NVME_SGL_DATA_BLOCK_DESC << 4;
+    Sq->Psdt     = NVME_PSDT_SGL_MPTR_CONTIGUOUS;
+  } else if ((Offset + Bytes) > (EFI_PAGE_SIZE * 2)) {
+    //
+    // If the buffer size spans more than two memory pages (page size as defined in CC.Mps),
+    // then build a PRP list in the second PRP submission queue entry.
     //
     PhyAddr = (Sq->Prp[0] + EFI_PAGE_SIZE) & ~(EFI_PAGE_SIZE - 1);
-    Prp = NvmeCreatePrpList (PciIo, PhyAddr, EFI_SIZE_TO_PAGES(Offset + Bytes) - 1, &PrpListHost, &PrpListNo, &MapPrpList);
+    Prp = NvmeCreatePrpList (Private, PhyAddr, EFI_SIZE_TO_PAGES(Offset + Bytes) - 1, &PrpList);
     if (Prp == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
       goto EXIT;
     }
 
@@ -633,9 +817,7 @@ NvmExpressPassThru (
     AsyncRequest->CallerEvent   = Event;
     AsyncRequest->MapData       = MapData;
     AsyncRequest->MapMeta       = MapMeta;
-    AsyncRequest->MapPrpList    = MapPrpList;
-    AsyncRequest->PrpListNo     = PrpListNo;
-    AsyncRequest->PrpListHost   = PrpListHost;
+    AsyncRequest->PrpList       = PrpList;
 
     OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
     InsertTailList (&Private->AsyncPassThruQueue, &AsyncRequest->Link);
@@ -732,15 +914,8 @@ EXIT:
              );
   }
 
-  if (MapPrpList != NULL) {
-    PciIo->Unmap (
-             PciIo,
-             MapPrpList
-             );
-  }
-
-  if (Prp != NULL) {
-    PciIo->FreeBuffer (PciIo, PrpListNo, PrpListHost);
+  if (PrpList != NULL) {
+    NvmeReleasePrpList (Private, PrpList);
   }
 
   if (TimerEvent != NULL) {
@@ -0,0 +1,354 @@
+/** @file
+  Cache of PCI BAR probe results across boots for PCI Bus module.
+
+  Sizing a BAR takes two configuration writes and a read with interrupts
+  disabled. With PcdPciBarProbeCache set, the value every device BAR returned
+  is saved in a variable at the end of full enumeration. On the next boot a
+  BAR is not probed again if the same device, identified by its vendor,
+  device, subsystem vendor, subsystem, revision, header type and class code,
+  is found at the same segment, bus, device and function. The first BAR of
+  such a device is still probed, and the other entries of the device are only
+  used if it returned the recorded value. Any device that does not match is
+  probed as usual and the variable is rewritten with the new results.
+
+  Only BARs sized by PciParseBar() go through the cache. Bridge window and
+  option ROM probes, and the probes done while rejecting resources, always
+  access the hardware.
+
+Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include "PciBus.h"
+
+BOOLEAN                          mBarCacheLoaded      = FALSE;
+
+//
+// Results recorded by the previous boot. Registers are probed in the same
+// order on every boot, so lookups start where the last hit ended.
+//
+EDKII_PCI_BAR_PROBE_CACHE        *mBarCache           = NULL;
+EDKII_PCI_BAR_PROBE_CACHE_ENTRY  *mBarCacheEntry      = NULL;
+UINTN                            mBarCacheCursor      = 0;
+
+//
+// The device whose first BAR returned the recorded value. Only the entries of
+// this device are used for its other BARs.
+//
+PCI_IO_DEVICE                    *mBarCacheTrustedDevice = NULL;
+
+//
+// Results of the full enumerations of this boot. Each full enumeration saves
+// them when it ends.
+//
+EDKII_PCI_BAR_PROBE_CACHE_ENTRY  *mBarProbeLog        = NULL;
+UINTN                            mBarProbeLogCount    = 0;
+UINTN                            mMaxBarProbeLogCount = 0;
+
+/**
+  Fill a cache entry identifying a register of a device.
+
+  @param PciIoDevice     Device instance.
+  @param Offset          Offset of the register in configuration space.
+  @param Entry           The entry to fill. BarLengthValue is set to zero.
+
+**/
+VOID
+PciBarCacheFillEntry (
+  IN  PCI_IO_DEVICE                    *PciIoDevice,
+  IN  UINTN                            Offset,
+  OUT EDKII_PCI_BAR_PROBE_CACHE_ENTRY  *Entry
+  )
+{
+  ZeroMem (Entry, sizeof (*Entry));
+  Entry->Segment    = (UINT16) PciIoDevice->PciRootBridgeIo->SegmentNumber;
+  Entry->Bus        = PciIoDevice->BusNumber;
+  Entry->Device     = PciIoDevice->DeviceNumber;
+  Entry->Function   = PciIoDevice->FunctionNumber;
+  Entry->Offset     = (UINT8) Offset;
+  Entry->VendorId   = PciIoDevice->Pci.Hdr.VendorId;
+  Entry->DeviceId   = PciIoDevice->Pci.Hdr.DeviceId;
+  Entry->RevisionId = PciIoDevice->Pci.Hdr.RevisionID;
+  Entry->HeaderType = PciIoDevice->Pci.Hdr.HeaderType;
+  CopyMem (Entry->ClassCode, PciIoDevice->Pci.Hdr.ClassCode, sizeof (Entry->ClassCode));
+
+  //
+  // Bridges have no subsystem IDs in their configuration header.
+  //
+  if ((PciIoDevice->Pci.Hdr.HeaderType & HEADER_LAYOUT_CODE) == HEADER_TYPE_DEVICE) {
+    Entry->SubsystemVendorId = PciIoDevice->Pci.Device.SubsystemVendorID;
+    Entry->SubsystemId       = PciIoDevice->Pci.Device.SubsystemID;
+  }
+}
+
+/**
+  Load the BAR probe results recorded by the previous boot.
+
+  Does nothing if PcdPciBarProbeCache is FALSE or the results are already
+  loaded.
+
+**/
+VOID
+PciBarCacheLoad (
+  VOID
+  )
+{
+  EFI_STATUS                 Status;
+  EDKII_PCI_BAR_PROBE_CACHE  *Cache;
+  UINTN                      Size;
+
+  if (!FeaturePcdGet (PcdPciBarProbeCache) || mBarCacheLoaded) {
+    return;
+  }
+
+  mBarCacheLoaded = TRUE;
+
+  Status = GetVariable2 (
+             EDKII_PCI_BAR_PROBE_CACHE_VARIABLE_NAME,
+             &gEdkiiPciBarProbeCacheGuid,
+             (VOID **) &Cache,
+             &Size
+             );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  if ((Size < sizeof (EDKII_PCI_BAR_PROBE_CACHE)) ||
+      (Cache->Version != EDKII_PCI_BAR_PROBE_CACHE_VERSION) ||
+      (Cache->EntryCount != (Size - sizeof (EDKII_PCI_BAR_PROBE_CACHE)) / sizeof (EDKII_PCI_BAR_PROBE_CACHE_ENTRY)) ||
+      ((Size - sizeof (EDKII_PCI_BAR_PROBE_CACHE)) % sizeof (EDKII_PCI_BAR_PROBE_CACHE_ENTRY) != 0)) {
+    DEBUG ((EFI_D_INFO, "PciBus: Ignore malformed BAR probe cache\n"));
+    FreePool (Cache);
+    return;
+  }
+
+  mBarCache      = Cache;
+  mBarCacheEntry = (EDKII_PCI_BAR_PROBE_CACHE_ENTRY *) (Cache + 1);
+}
+
+/**
+  Look up the BAR probe result recorded by the previous boot for a register.
+
+  @param PciIoDevice     Device instance.
+  @param Offset          Offset of the register in configuration space.
+  @param BarLengthValue  The value read back after writing all ones.
+
+  @retval TRUE   The same device was found at the same address last boot,
+                 BarLengthValue holds the value it returned.
+  @retval FALSE  The register must be probed.
+
+**/
+BOOLEAN
+PciBarCacheLookup (
+  IN  PCI_IO_DEVICE   *PciIoDevice,
+  IN  UINTN           Offset,
+  OUT UINT32          *BarLengthValue
+  )
+{
+  EDKII_PCI_BAR_PROBE_CACHE_ENTRY  Key;
+  UINTN                            Index;
+  UINTN                            Count;
+
+  if (!FeaturePcdGet (PcdPciBarProbeCache) || (mBarCache == NULL) || (Offset > MAX_UINT8)) {
+    return FALSE;
+  }
+
+  PciBarCacheFillEntry (PciIoDevice, Offset, &Key);
+
+  Index = mBarCacheCursor;
+  for (Count = 0; Count < mBarCache->EntryCount; Count++) {
+    if (Index >= mBarCache->EntryCount) {
+      Index = 0;
+    }
+
+    if (CompareMem (&mBarCacheEntry[Index], &Key, OFFSET_OF (EDKII_PCI_BAR_PROBE_CACHE_ENTRY, BarLengthValue)) == 0) {
+      mBarCacheCursor = Index + 1;
+      *BarLengthValue = mBarCacheEntry[Index].BarLengthValue;
+      return TRUE;
+    }
+
+    Index++;
+  }
+
+  return FALSE;
+}
+
+/**
+  Record the BAR probe result of a register for the next boot.
+
+  Only BARs probed during full enumeration are recorded. Devices enumerated
+  later, like hot plugged ones, would otherwise be appended to results that
+  have already been saved.
+
+  @param PciIoDevice     Device instance.
+  @param Offset          Offset of the register in configuration space.
+  @param BarLengthValue  The value read back after writing all ones.
+
+**/
+VOID
+PciBarCacheRecord (
+  IN  PCI_IO_DEVICE   *PciIoDevice,
+  IN  UINTN           Offset,
+  IN  UINT32          BarLengthValue
+  )
+{
+  EDKII_PCI_BAR_PROBE_CACHE_ENTRY  *TempLog;
+
+  if (!FeaturePcdGet (PcdPciBarProbeCache) || !gFullEnumeration || (Offset > MAX_UINT8)) {
+    return;
+  }
+
+  if (mBarProbeLogCount >= mMaxBarProbeLogCount) {
+
+    TempLog = ReallocatePool (
+                mMaxBarProbeLogCount * sizeof (EDKII_PCI_BAR_PROBE_CACHE_ENTRY),
+                (mMaxBarProbeLogCount + 0x40) * sizeof (EDKII_PCI_BAR_PROBE_CACHE_ENTRY),
+                mBarProbeLog
+                );
+    if (TempLog == NULL) {
+      return;
+    }
+
+    mBarProbeLog          = TempLog;
+    mMaxBarProbeLogCount += 0x40;
+  }
+
+  PciBarCacheFillEntry (PciIoDevice, Offset, &mBarProbeLog[mBarProbeLogCount]);
+  mBarProbeLog[mBarProbeLogCount].BarLengthValue = BarLengthValue;
+  mBarProbeLogCount++;
+}
+
+/**
+  Check whether a device BAR exists, reusing the value the same device
+  returned at the same address last boot when it can be trusted.
+
+  The first BAR of a device is always probed. The recorded value of any
+  other BAR is only used if the first BAR returned its recorded value, and
+  if the type bits of the current BAR value match the recorded ones.
+
+  @param PciIoDevice       A pointer to the PCI_IO_DEVICE.
+  @param Offset            The offset.
+  @param BarLengthValue    The bar length value returned.
+  @param OriginalBarValue  The original bar value returned.
+
+  @retval EFI_NOT_FOUND    The bar doesn't exist.
+  @retval EFI_SUCCESS      The bar exist.
+
+**/
+EFI_STATUS
+PciBarCacheBarExisted (
+  IN  PCI_IO_DEVICE *PciIoDevice,
+  IN  UINTN         Offset,
+  OUT UINT32        *BarLengthValue,
+  OUT UINT32        *OriginalBarValue
+  )
+{
+  EFI_STATUS          Status;
+  EFI_PCI_IO_PROTOCOL *PciIo;
+  UINT32              OriginalValue;
+  UINT32              Value;
+  UINT32              CachedValue;
+  UINT32              TypeMask;
+
+  if (!FeaturePcdGet (PcdPciBarProbeCache)) {
+    return BarExisted (PciIoDevice, Offset, BarLengthValue, OriginalBarValue);
+  }
+
+  if (Offset == PCI_BASE_ADDRESSREG_OFFSET) {
+    mBarCacheTrustedDevice = NULL;
+    Status = BarExisted (PciIoDevice, Offset, &Value, &OriginalValue);
+    if (PciBarCacheLookup (PciIoDevice, Offset, &CachedValue) && (CachedValue == Value)) {
+      mBarCacheTrustedDevice = PciIoDevice;
+    }
+  } else if ((mBarCacheTrustedDevice == PciIoDevice) &&
+             PciBarCacheLookup (PciIoDevice, Offset, &Value)) {
+    PciIo = &PciIoDevice->PciIo;
+    PciIo->Pci.Read (PciIo, EfiPciIoWidthUint32, (UINT8) Offset, 1, &OriginalValue);
+
+    //
+    // The low bits of a BAR encode its type and are read-only, so they read
+    // the same before and after writing all ones.
+    //
+    TypeMask = ((Value & BIT0) != 0) ? 0x3 : 0xF;
+    if (((OriginalValue ^ Value) & TypeMask) == 0) {
+      Status = (Value == 0) ? EFI_NOT_FOUND : EFI_SUCCESS;
+    } else {
+      Status = BarExisted (PciIoDevice, Offset, &Value, &OriginalValue);
+    }
+  } else {
+    Status = BarExisted (PciIoDevice, Offset, &Value, &OriginalValue);
+  }
+
+  PciBarCacheRecord (PciIoDevice, Offset, Value);
+
+  if (BarLengthValue != NULL) {
+    *BarLengthValue = Value;
+  }
+
+  if (OriginalBarValue != NULL) {
+    *OriginalBarValue = OriginalValue;
+  }
+
+  return Status;
+}
+
+/**
+  Save the BAR probe results of this boot if they differ from the ones
+  recorded by the previous boot.
+
+**/
+VOID
+PciBarCacheSave (
+  VOID
+  )
+{
+  EFI_STATUS                 Status;
+  EDKII_PCI_BAR_PROBE_CACHE  *Cache;
+  UINTN                      Size;
+
+  if (!FeaturePcdGet (PcdPciBarProbeCache) || (mBarProbeLogCount == 0)) {
+    return;
+  }
+
+  if ((mBarCache != NULL) &&
+      (mBarCache->EntryCount == mBarProbeLogCount) &&
+      (CompareMem (mBarCacheEntry, mBarProbeLog, mBarProbeLogCount * sizeof (EDKII_PCI_BAR_PROBE_CACHE_ENTRY)) == 0)) {
+    return;
+  }
+
+  Size  = sizeof (EDKII_PCI_BAR_PROBE_CACHE) + mBarProbeLogCount * sizeof (EDKII_PCI_BAR_PROBE_CACHE_ENTRY);
+  Cache = AllocatePool (Size);
+  if (Cache == NULL) {
+    return;
+  }
+
+  Cache->Version    = EDKII_PCI_BAR_PROBE_CACHE_VERSION;
+  Cache->EntryCount = (UINT32) mBarProbeLogCount;
+  CopyMem (Cache + 1, mBarProbeLog, mBarProbeLogCount * sizeof (EDKII_PCI_BAR_PROBE_CACHE_ENTRY));
+
+  Status = gRT->SetVariable (
+                  EDKII_PCI_BAR_PROBE_CACHE_VARIABLE_NAME,
+                  &gEdkiiPciBarProbeCacheGuid,
+                  EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                  Size,
+                  Cache
+                  );
+  DEBUG ((EFI_D_INFO, "PciBus: Save BAR probe cache of %d entries - %r\n", mBarProbeLogCount, Status));
+
+  //
+  // The saved results become the reference for later enumerations of this boot.
+  //
+  if (mBarCache != NULL) {
+    FreePool (mBarCache);
+  }
+  mBarCache       = Cache;
+  mBarCacheEntry  = (EDKII_PCI_BAR_PROBE_CACHE_ENTRY *) (Cache + 1);
+  mBarCacheCursor = 0;
+}
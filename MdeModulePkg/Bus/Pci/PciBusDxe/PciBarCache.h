@@ -0,0 +1,103 @@
+/** @file
+  Cache of PCI BAR probe results across boots for PCI Bus module.
+
+Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#ifndef _EFI_PCI_BAR_CACHE_H_
+#define _EFI_PCI_BAR_CACHE_H_
+
+/**
+  Load the BAR probe results recorded by the previous boot.
+
+  Does nothing if PcdPciBarProbeCache is FALSE or the results are already
+  loaded.
+
+**/
+VOID
+PciBarCacheLoad (
+  VOID
+  );
+
+/**
+  Look up the BAR probe result recorded by the previous boot for a register.
+
+  @param PciIoDevice     Device instance.
+  @param Offset          Offset of the register in configuration space.
+  @param BarLengthValue  The value read back after writing all ones.
+
+  @retval TRUE   The same device was found at the same address last boot,
+                 BarLengthValue holds the value it returned.
+  @retval FALSE  The register must be probed.
+
+**/
+BOOLEAN
+PciBarCacheLookup (
+  IN  PCI_IO_DEVICE   *PciIoDevice,
+  IN  UINTN           Offset,
+  OUT UINT32          *BarLengthValue
+  );
+
+/**
+  Record the BAR probe result of a register for the next boot.
+
+  Only BARs probed during full enumeration are recorded. Devices enumerated
+  later, like hot plugged ones, would otherwise be appended to results that
+  have already been saved.
+
+  @param PciIoDevice     Device instance.
+  @param Offset          Offset of the register in configuration space.
+  @param BarLengthValue  The value read back after writing all ones.
+
+**/
+VOID
+PciBarCacheRecord (
+  IN  PCI_IO_DEVICE   *PciIoDevice,
+  IN  UINTN           Offset,
+  IN  UINT32          BarLengthValue
+  );
+
+/**
+  Check whether a device BAR exists, reusing the value the same device
+  returned at the same address last boot when it can be trusted.
+
+  The first BAR of a device is always probed. The recorded value of any
+  other BAR is only used if the first BAR returned its recorded value, and
+  if the type bits of the current BAR value match the recorded ones.
+
+  @param PciIoDevice       A pointer to the PCI_IO_DEVICE.
+  @param Offset            The offset.
+  @param BarLengthValue    The bar length value returned.
+  @param OriginalBarValue  The original bar value returned.
+
+  @retval EFI_NOT_FOUND    The bar doesn't exist.
+  @retval EFI_SUCCESS      The bar exist.
+
+**/
+EFI_STATUS
+PciBarCacheBarExisted (
+  IN  PCI_IO_DEVICE *PciIoDevice,
+  IN  UINTN         Offset,
+  OUT UINT32        *BarLengthValue,
+  OUT UINT32        *OriginalBarValue
+  );
+
+/**
+  Save the BAR probe results of this boot if they differ from the ones
+  recorded by the previous boot.
+
+**/
+VOID
+PciBarCacheSave (
+  VOID
+  );
+
+#endif
@@ -34,6 +34,8 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Protocol/PciEnumerationComplete.h>
 #include <Protocol/IoMmu.h>
 
+#include <Guid/PciBarProbeCache.h>
+
 #include <Library/DebugLib.h>
 #include <Library/UefiDriverEntryPoint.h>
 #include <Library/BaseLib.h>
@@ -42,9 +44,11 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/ReportStatusCodeLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/PcdLib.h>
 #include <Library/PeCoffLib.h>
+#include <Library/PerformanceLib.h>
 
 #include <IndustryStandard/Pci.h>
 #include <IndustryStandard/PeImage.h>
@@ -81,6 +85,7 @@ typedef enum {
 #include "PciEnumeratorSupport.h"
 #include "PciDriverOverride.h"
 #include "PciRomTable.h"
+#include "PciBarCache.h"
 #include "PciOptionRomSupport.h"
 #include "PciPowerManagement.h"
 #include "PciHotPlugSupport.h"
@@ -30,10 +30,7 @@ PciEnumerator (
   IN EFI_HANDLE                    Controller
   )
 {
-  EFI_HANDLE                                        HostBridgeHandle;
   EFI_STATUS                                        Status;
-  EFI_PCI_HOST_BRIDGE_RESOURCE_ALLOCATION_PROTOCOL  *PciResAlloc;
-  EFI_PCI_ROOT_BRIDGE_IO_PROTOCOL                   *PciRootBridgeIo;
 
   //
   // If PCI bus has already done the full enumeration, never do it again
@@ -42,6 +39,33 @@ PciEnumerator (
     return PciEnumeratorLight (Controller);
   }
 
+  PERF_START_EX (Controller, "PciEnum", "PciBus", 0, 0);
+  Status = PciFullEnumerator (Controller);
+  PERF_END_EX (Controller, "PciEnum", "PciBus", 0, 0);
+
+  return Status;
+}
+
+/**
+  Enumerate and assign resources to all PCI devices of the host bridge
+  the given root bridge belongs to.
+
+  @param Controller  Parent controller handle.
+
+  @retval EFI_SUCCESS    PCI enumeration finished successfully.
+  @retval other          Some error occurred when enumerating the pci bus system.
+
+**/
+EFI_STATUS
+PciFullEnumerator (
+  IN EFI_HANDLE                    Controller
+  )
+{
+  EFI_HANDLE                                        HostBridgeHandle;
+  EFI_STATUS                                        Status;
+  EFI_PCI_HOST_BRIDGE_RESOURCE_ALLOCATION_PROTOCOL  *PciResAlloc;
+  EFI_PCI_ROOT_BRIDGE_IO_PROTOCOL                   *PciRootBridgeIo;
+
   //
   // Get the rootbridge Io protocol to find the host bridge handle
   //
@@ -88,6 +112,11 @@ PciEnumerator (
     return Status;
   }
 
+  //
+  // Pick up the BAR probe results of the previous boot
+  //
+  PciBarCacheLoad ();
+
   //
   // Start the bus allocation phase
   //
@@ -134,6 +163,8 @@ PciEnumerator (
 
   gFullEnumeration = FALSE;
 
+  PciBarCacheSave ();
+
   Status = gBS->InstallProtocolInterface (
                   &HostBridgeHandle,
                   &gEfiPciEnumerationCompleteProtocolGuid,
@@ -32,6 +32,21 @@ PciEnumerator (
   IN EFI_HANDLE                    Controller
   );
 
+/**
+  Enumerate and assign resources to all PCI devices of the host bridge
+  the given root bridge belongs to.
+
+  @param Controller  Parent controller handle.
+
+  @retval EFI_SUCCESS    PCI enumeration finished successfully.
+  @retval other          Some error occurred when enumerating the pci bus system.
+
+**/
+EFI_STATUS
+PciFullEnumerator (
+  IN EFI_HANDLE                    Controller
+  );
+
 /**
   Enumerate PCI root bridge.
 
@@ -1775,7 +1775,7 @@ PciParseBar (
   OriginalValue = 0;
   Value         = 0;
 
-  Status = BarExisted (
+  Status = PciBarCacheBarExisted (
              PciIoDevice,
              Offset,
              &Value,
@@ -1883,7 +1883,7 @@ PciParseBar (
       //
       Offset += 4;
 
-      Status = BarExisted (
+      Status = PciBarCacheBarExisted (
                  PciIoDevice,
                  Offset,
                  &Value,
@@ -366,6 +366,92 @@ ContainEfiImage (
   return FALSE;
 }
 
+/**
+  Read a range of the expansion ROM through the root bridge.
+
+  The aligned part of the range is read with DWORD accesses, which every
+  expansion ROM must accept, so a ROM image costs a quarter of the MMIO
+  read transactions of a byte wide copy. The unaligned head and tail are
+  read byte by byte.
+
+  @param PciDevice   Pci device instance.
+  @param Address     Memory address of the first byte to read.
+  @param Length      Number of bytes to read.
+  @param Buffer      Buffer receiving the data.
+
+  @retval EFI_SUCCESS  The data was read from the ROM.
+  @retval other        The root bridge failed to read the ROM.
+
+**/
+EFI_STATUS
+RomBarRead (
+  IN  PCI_IO_DEVICE   *PciDevice,
+  IN  UINT32          Address,
+  IN  UINT32          Length,
+  OUT VOID            *Buffer
+  )
+{
+  EFI_PCI_ROOT_BRIDGE_IO_PROTOCOL  *PciRootBridgeIo;
+  UINT8                            *Destination;
+  UINT32                           Count;
+  UINT32                           Data;
+  EFI_STATUS                       Status;
+
+  PciRootBridgeIo = PciDevice->PciRootBridgeIo;
+  Destination     = (UINT8 *) Buffer;
+
+  //
+  // Read the unaligned head byte by byte.
+  //
+  Count = MIN ((UINT32) (-(INT32) Address) & 0x3, Length);
+  if (Count != 0) {
+    Status = PciRootBridgeIo->Mem.Read (PciRootBridgeIo, EfiPciWidthUint8, Address, Count, Destination);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+    Address     += Count;
+    Destination += Count;
+    Length      -= Count;
+  }
+
+  //
+  // Read the aligned body with DWORD accesses. The destination buffer is
+  // only guaranteed to be byte aligned, so bounce through a local when it
+  // is not.
+  //
+  Count = Length >> 2;
+  if (Count != 0) {
+    if (((UINTN) Destination & 0x3) == 0) {
+      Status = PciRootBridgeIo->Mem.Read (PciRootBridgeIo, EfiPciWidthUint32, Address, Count, Destination);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+      Address     += Count << 2;
+      Destination += Count << 2;
+    } else {
+      for (; Count != 0; Count--) {
+        Status = PciRootBridgeIo->Mem.Read (PciRootBridgeIo, EfiPciWidthUint32, Address, 1, &Data);
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
+        CopyMem (Destination, &Data, sizeof (Data));
+        Address     += sizeof (Data);
+        Destination += sizeof (Data);
+      }
+    }
+    Length &= 0x3;
+  }
+
+  //
+  // Read the tail byte by byte.
+  //
+  if (Length != 0) {
+    return PciRootBridgeIo->Mem.Read (PciRootBridgeIo, EfiPciWidthUint8, Address, Length, Destination);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Load Option Rom image for specified PCI device.
 
@@ -397,6 +483,18 @@ LoadOpRomImage (
   UINT32                    LegacyImageLength;
   UINT8                     *RomInMemory;
   UINT8                     CodeType;
+  UINT32                    PerfId;
+
+  //
+  // Identify the device in the performance records by its PCI address.
+  //
+  PerfId = (UINT32) EFI_PCI_ADDRESS (
+                      PciDevice->BusNumber,
+                      PciDevice->DeviceNumber,
+                      PciDevice->FunctionNumber,
+                      0
+                      );
+  PERF_START_EX (PciDevice, "OpRomLoad", "PciBus", 0, PerfId);
 
   RomSize       = PciDevice->RomSize;
 
@@ -428,12 +526,14 @@ LoadOpRomImage (
   //
   RomHeader = AllocatePool (sizeof (PCI_EXPANSION_ROM_HEADER));
   if (RomHeader == NULL) {
+    PERF_END_EX (PciDevice, "OpRomLoad", "PciBus", 0, PerfId);
     return EFI_OUT_OF_RESOURCES;
   }
 
   RomPcir = AllocatePool (sizeof (PCI_DATA_STRUCTURE));
   if (RomPcir == NULL) {
     FreePool (RomHeader);
+    PERF_END_EX (PciDevice, "OpRomLoad", "PciBus", 0, PerfId);
     return EFI_OUT_OF_RESOURCES;
   }
 
@@ -450,13 +550,7 @@ LoadOpRomImage (
   LegacyImageLength = 0;
 
   do {
-    PciDevice->PciRootBridgeIo->Mem.Read (
-                                      PciDevice->PciRootBridgeIo,
-                                      EfiPciWidthUint8,
-                                      RomBarOffset,
-                                      sizeof (PCI_EXPANSION_ROM_HEADER),
-                                      (UINT8 *) RomHeader
-                                      );
+    RomBarRead (PciDevice, RomBarOffset, sizeof (PCI_EXPANSION_ROM_HEADER), RomHeader);
 
     if (RomHeader->Signature != PCI_EXPANSION_ROM_HEADER_SIGNATURE) {
       RomBarOffset = RomBarOffset + 512;
@@ -479,13 +573,7 @@ LoadOpRomImage (
         RomImageSize + OffsetPcir + sizeof (PCI_DATA_STRUCTURE) > RomSize) {
       break;
     }
-    PciDevice->PciRootBridgeIo->Mem.Read (
-                                      PciDevice->PciRootBridgeIo,
-                                      EfiPciWidthUint8,
-                                      RomBarOffset + OffsetPcir,
-                                      sizeof (PCI_DATA_STRUCTURE),
-                                      (UINT8 *) RomPcir
-                                      );
+    RomBarRead (PciDevice, RomBarOffset + OffsetPcir, sizeof (PCI_DATA_STRUCTURE), RomPcir);
     //
     // If a valid signature is not present in the PCI Data Structure, no further images can be located.
     //
@@ -519,19 +607,15 @@ LoadOpRomImage (
       RomDecode (PciDevice, RomBarIndex, RomBar, FALSE);
       FreePool (RomHeader);
       FreePool (RomPcir);
+      PERF_END_EX (PciDevice, "OpRomLoad", "PciBus", 0, PerfId);
       return EFI_OUT_OF_RESOURCES;
     }
 
     //
-    // Copy Rom image into memory
+    // Copy Rom image into memory. Only the images found above are copied,
+    // not the whole ROM BAR window.
     //
-    PciDevice->PciRootBridgeIo->Mem.Read (
-                                      PciDevice->PciRootBridgeIo,
-                                      EfiPciWidthUint8,
-                                      RomBar,
-                                      (UINT32) RomImageSize,
-                                      Image
-                                      );
+    RomBarRead (PciDevice, RomBar, (UINT32) RomImageSize, Image);
     RomInMemory = Image;
   }
 
@@ -561,6 +645,8 @@ LoadOpRomImage (
   FreePool (RomHeader);
   FreePool (RomPcir);
 
+  PERF_END_EX (PciDevice, "OpRomLoad", "PciBus", 0, PerfId);
+
   return RetStatus;
 }
 
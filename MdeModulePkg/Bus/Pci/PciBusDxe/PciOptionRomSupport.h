@@ -91,6 +91,31 @@ GetOpRomInfo (
   IN OUT PCI_IO_DEVICE    *PciIoDevice
   );
 
+/**
+  Read a range of the expansion ROM through the root bridge.
+
+  The aligned part of the range is read with DWORD accesses, which every
+  expansion ROM must accept, so a ROM image costs a quarter of the MMIO
+  read transactions of a byte wide copy. The unaligned head and tail are
+  read byte by byte.
+
+  @param PciDevice   Pci device instance.
+  @param Address     Memory address of the first byte to read.
+  @param Length      Number of bytes to read.
+  @param Buffer      Buffer receiving the data.
+
+  @retval EFI_SUCCESS  The data was read from the ROM.
+  @retval other        The root bridge failed to read the ROM.
+
+**/
+EFI_STATUS
+RomBarRead (
+  IN  PCI_IO_DEVICE   *PciDevice,
+  IN  UINT32          Address,
+  IN  UINT32          Length,
+  OUT VOID            *Buffer
+  );
+
 /**
   Load Option Rom image for specified PCI device.
 
@@ -57,6 +57,21 @@ typedef struct {
 } MAP_INFO;
 #define MAP_INFO_FROM_LINK(a) CR (a, MAP_INFO, Link, MAP_INFO_SIGNATURE)
 
+//
+// Bounce buffers below 4GB are kept for reuse after Unmap() in power of two
+// size classes from 1 page up to 1 << (BOUNCE_CLASS_COUNT - 1) pages. At most
+// BOUNCE_POOL_DEPTH buffers are kept per class; larger or excess buffers are
+// freed.
+//
+#define BOUNCE_CLASS_COUNT  6
+#define BOUNCE_POOL_DEPTH   4
+
+typedef struct {
+  UINT64                                    Maps;
+  UINT64                                    Bytes;
+  UINT64                                    PoolHits;
+} BOUNCE_STATISTICS;
+
 #define PCI_ROOT_BRIDGE_SIGNATURE SIGNATURE_32 ('_', 'p', 'r', 'b')
 
 typedef struct {
@@ -82,6 +97,13 @@ typedef struct {
 
   BOOLEAN                           ResourceSubmitted;
   LIST_ENTRY                        Maps;
+
+  //
+  // Free MAP_INFO structures whose bounce buffers can be reused, per size class.
+  //
+  LIST_ENTRY                        BouncePool[BOUNCE_CLASS_COUNT];
+  UINTN                             BouncePoolCount[BOUNCE_CLASS_COUNT];
+  BOUNCE_STATISTICS                 BounceStatistics;
 } PCI_ROOT_BRIDGE_INSTANCE;
 
 #define ROOT_BRIDGE_FROM_THIS(a) CR (a, PCI_ROOT_BRIDGE_INSTANCE, RootBridgeIo, PCI_ROOT_BRIDGE_SIGNATURE)
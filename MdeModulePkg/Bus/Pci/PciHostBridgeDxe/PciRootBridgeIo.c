@@ -74,6 +74,7 @@ CreateRootBridge (
   PCI_RESOURCE_TYPE        Index;
   CHAR16                   *DevicePathStr;
   PCI_ROOT_BRIDGE_APERTURE *Aperture;
+  UINTN                    Class;
 
   DevicePathStr = NULL;
 
@@ -171,6 +172,9 @@ CreateRootBridge (
     );
   ASSERT (RootBridge->ConfigBuffer != NULL);
   InitializeListHead (&RootBridge->Maps);
+  for (Class = 0; Class < BOUNCE_CLASS_COUNT; Class++) {
+    InitializeListHead (&RootBridge->BouncePool[Class]);
+  }
 
   CopyMem (&RootBridge->Bus, &Bridge->Bus, sizeof (PCI_ROOT_BRIDGE_APERTURE));
   CopyMem (&RootBridge->Io, &Bridge->Io, sizeof (PCI_ROOT_BRIDGE_APERTURE));
@@ -1023,6 +1027,123 @@ RootBridgeIoPciWrite (
   return RootBridgeIoPciAccess (This, FALSE, Width, Address, Count, Buffer);
 }
 
+/**
+  Return the bounce buffer size class of a transfer.
+
+  @param Pages  The number of pages of the transfer.
+
+  @return The size class, or BOUNCE_CLASS_COUNT if the transfer is larger
+          than the largest class.
+**/
+UINTN
+BounceClass (
+  IN UINTN  Pages
+  )
+{
+  UINTN  Class;
+
+  for (Class = 0; Class < BOUNCE_CLASS_COUNT; Class++) {
+    if (Pages <= ((UINTN) 1 << Class)) {
+      break;
+    }
+  }
+  return Class;
+}
+
+/**
+  Get a MAP_INFO structure with a bounce buffer below 4GB of at least the
+  given number of pages, reusing one released by an earlier Unmap() if
+  possible.
+
+  @param RootBridge  The root bridge instance.
+  @param Pages       The number of pages needed.
+
+  @return The MAP_INFO structure, or NULL if it could not be allocated.
+**/
+MAP_INFO *
+AcquireBounceBuffer (
+  IN PCI_ROOT_BRIDGE_INSTANCE  *RootBridge,
+  IN UINTN                     Pages
+  )
+{
+  EFI_STATUS                   Status;
+  MAP_INFO                     *MapInfo;
+  LIST_ENTRY                   *Link;
+  UINTN                        Class;
+
+  Class = BounceClass (Pages);
+  if (Class < BOUNCE_CLASS_COUNT) {
+    if (!IsListEmpty (&RootBridge->BouncePool[Class])) {
+      Link = GetFirstNode (&RootBridge->BouncePool[Class]);
+      RemoveEntryList (Link);
+      RootBridge->BouncePoolCount[Class]--;
+      RootBridge->BounceStatistics.PoolHits++;
+      return MAP_INFO_FROM_LINK (Link);
+    }
+    Pages = (UINTN) 1 << Class;
+  }
+
+  MapInfo = AllocatePool (sizeof (MAP_INFO));
+  if (MapInfo == NULL) {
+    return NULL;
+  }
+
+  MapInfo->Signature         = MAP_INFO_SIGNATURE;
+  MapInfo->NumberOfPages     = Pages;
+  MapInfo->MappedHostAddress = SIZE_4GB - 1;
+
+  Status = gBS->AllocatePages (
+                  AllocateMaxAddress,
+                  EfiBootServicesData,
+                  MapInfo->NumberOfPages,
+                  &MapInfo->MappedHostAddress
+                  );
+  if (EFI_ERROR (Status)) {
+    FreePool (MapInfo);
+    return NULL;
+  }
+
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "%s: Allocate %d bounce pages, %ld maps (%ld from pool) bounced %ld bytes\n",
+    RootBridge->DevicePathStr,
+    MapInfo->NumberOfPages,
+    RootBridge->BounceStatistics.Maps,
+    RootBridge->BounceStatistics.PoolHits,
+    RootBridge->BounceStatistics.Bytes
+    ));
+
+  return MapInfo;
+}
+
+/**
+  Keep the bounce buffer of a MAP_INFO structure for reuse, or free it if
+  it has no size class or its class is full.
+
+  @param RootBridge  The root bridge instance.
+  @param MapInfo     The MAP_INFO structure to release.
+**/
+VOID
+ReleaseBounceBuffer (
+  IN PCI_ROOT_BRIDGE_INSTANCE  *RootBridge,
+  IN MAP_INFO                  *MapInfo
+  )
+{
+  UINTN                        Class;
+
+  Class = BounceClass (MapInfo->NumberOfPages);
+  if ((Class < BOUNCE_CLASS_COUNT) &&
+      (MapInfo->NumberOfPages == ((UINTN) 1 << Class)) &&
+      (RootBridge->BouncePoolCount[Class] < BOUNCE_POOL_DEPTH)) {
+    InsertHeadList (&RootBridge->BouncePool[Class], &MapInfo->Link);
+    RootBridge->BouncePoolCount[Class]++;
+    return;
+  }
+
+  gBS->FreePages (MapInfo->MappedHostAddress, MapInfo->NumberOfPages);
+  FreePool (MapInfo);
+}
+
 /**
   Provides the PCI controller-specific address needed to access
   system memory for DMA.
@@ -1118,10 +1239,10 @@ RootBridgeIoMap (
     }
 
     //
-    // Allocate a MAP_INFO structure to remember the mapping when Unmap() is
-    // called later.
+    // Get a MAP_INFO structure to remember the mapping when Unmap() is
+    // called later, together with a buffer below 4GB to map the transfer to.
     //
-    MapInfo = AllocatePool (sizeof (MAP_INFO));
+    MapInfo = AcquireBounceBuffer (RootBridge, EFI_SIZE_TO_PAGES (*NumberOfBytes));
     if (MapInfo == NULL) {
       *NumberOfBytes = 0;
       return EFI_OUT_OF_RESOURCES;
@@ -1130,27 +1251,12 @@ RootBridgeIoMap (
     //
     // Initialize the MAP_INFO structure
     //
-    MapInfo->Signature         = MAP_INFO_SIGNATURE;
     MapInfo->Operation         = Operation;
     MapInfo->NumberOfBytes     = *NumberOfBytes;
-    MapInfo->NumberOfPages     = EFI_SIZE_TO_PAGES (MapInfo->NumberOfBytes);
     MapInfo->HostAddress       = PhysicalAddress;
-    MapInfo->MappedHostAddress = SIZE_4GB - 1;
 
-    //
-    // Allocate a buffer below 4GB to map the transfer to.
-    //
-    Status = gBS->AllocatePages (
-                    AllocateMaxAddress,
-                    EfiBootServicesData,
-                    MapInfo->NumberOfPages,
-                    &MapInfo->MappedHostAddress
-                    );
-    if (EFI_ERROR (Status)) {
-      FreePool (MapInfo);
-      *NumberOfBytes = 0;
-      return Status;
-    }
+    RootBridge->BounceStatistics.Maps++;
+    RootBridge->BounceStatistics.Bytes += MapInfo->NumberOfBytes;
 
     //
     // If this is a read operation from the Bus Master's point of view,
@@ -1270,10 +1376,9 @@ RootBridgeIoUnmap (
   }
 
   //
-  // Free the mapped buffer and the MAP_INFO structure.
+  // Keep the mapped buffer and the MAP_INFO structure for the next Map().
   //
-  gBS->FreePages (MapInfo->MappedHostAddress, MapInfo->NumberOfPages);
-  FreePool (Mapping);
+  ReleaseBounceBuffer (RootBridge, MapInfo);
   return EFI_SUCCESS;
 }
 
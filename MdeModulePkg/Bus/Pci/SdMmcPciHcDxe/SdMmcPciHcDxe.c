@@ -155,12 +155,22 @@ ProcessAsyncTaskList (
   Private = (SD_MMC_HC_PRIVATE_DATA*)Context;
 
   //
-  // Check if the first entry in the async I/O queue is done or not.
+  // Keep retiring the first entry of the async I/O queue as long as it is
+  // done, and start the next one right away. Upper layers queue several
+  // commands per request (e.g. SET_BLOCK_COUNT followed by the multi-block
+  // transfer), so waiting for the next timer tick between them would add
+  // a full timer period of idle bus time per command.
   //
-  Status = EFI_SUCCESS;
-  Trb    = NULL;
-  Link   = GetFirstNode (&Private->Queue);
-  if (!IsNull (&Private->Queue, Link)) {
+  while (TRUE) {
+    //
+    // Check if the first entry in the async I/O queue is done or not.
+    //
+    Status = EFI_SUCCESS;
+    Link   = GetFirstNode (&Private->Queue);
+    if (IsNull (&Private->Queue, Link)) {
+      return;
+    }
+
     Trb = SD_MMC_HC_TRB_FROM_THIS (Link);
     if (!Private->Slot[Trb->Slot].MediaPresent) {
       Status = EFI_NO_MEDIA;
@@ -182,27 +192,29 @@ ProcessAsyncTaskList (
       }
     }
     Status = SdMmcCheckTrbResult (Private, Trb);
-  }
 
 Done:
-  if ((Trb != NULL) && (Status == EFI_NOT_READY)) {
-    Packet = Trb->Packet;
-    if (Packet->Timeout == 0) {
-      InfiniteWait = TRUE;
-    } else {
-      InfiniteWait = FALSE;
-    }
-    if ((!InfiniteWait) && (Trb->Timeout-- == 0)) {
-      RemoveEntryList (Link);
-      Trb->Packet->TransactionStatus = EFI_TIMEOUT;
-      TrbEvent = Trb->Event;
-      SdMmcFreeTrb (Trb);
-      DEBUG ((DEBUG_VERBOSE, "ProcessAsyncTaskList(): Signal Event %p EFI_TIMEOUT\n", TrbEvent));
-      gBS->SignalEvent (TrbEvent);
+    if (Status == EFI_NOT_READY) {
+      Packet = Trb->Packet;
+      if (Packet->Timeout == 0) {
+        InfiniteWait = TRUE;
+      } else {
+        InfiniteWait = FALSE;
+      }
+      if ((!InfiniteWait) && (Trb->Timeout-- == 0)) {
+        RemoveEntryList (Link);
+        Trb->Packet->TransactionStatus = EFI_TIMEOUT;
+        TrbEvent = Trb->Event;
+        SdMmcFreeTrb (Trb);
+        DEBUG ((DEBUG_VERBOSE, "ProcessAsyncTaskList(): Signal Event %p EFI_TIMEOUT\n", TrbEvent));
+        gBS->SignalEvent (TrbEvent);
+      }
+      //
+      // The head entry is still in flight, check again on the next tick.
+      //
       return;
     }
-  }
-  if ((Trb != NULL) && (Status != EFI_NOT_READY)) {
+
     RemoveEntryList (Link);
     Trb->Packet->TransactionStatus = Status;
     TrbEvent = Trb->Event;
@@ -210,7 +222,6 @@ Done:
     DEBUG ((DEBUG_VERBOSE, "ProcessAsyncTaskList(): Signal Event %p with %r\n", TrbEvent, Status));
     gBS->SignalEvent (TrbEvent);
   }
-  return;
 }
 
 /**
@@ -0,0 +1,63 @@
+/** @file
+  PCI BAR probe cache variable definitions.
+
+  The PCI bus driver can record the value read back from every device BAR
+  after writing all ones to it, and reuse it on the next boot for the same
+  device at the same address instead of probing the BAR again.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#ifndef _PCI_BAR_PROBE_CACHE_H_
+#define _PCI_BAR_PROBE_CACHE_H_
+
+#define EDKII_PCI_BAR_PROBE_CACHE_GUID { \
+  0x0f442276, 0xb537, 0x4761, { 0x87, 0x3b, 0x94, 0x5b, 0x90, 0xe0, 0xc5, 0x1a } \
+};
+
+#define EDKII_PCI_BAR_PROBE_CACHE_VARIABLE_NAME  L"PciBarProbeCache"
+
+#define EDKII_PCI_BAR_PROBE_CACHE_VERSION        2
+
+//
+// One probed register. All fields but BarLengthValue identify the device and
+// the register; an entry is only used when all of them match the device found
+// during enumeration. The subsystem IDs are zero for bridges.
+//
+typedef struct {
+  UINT16  Segment;
+  UINT8   Bus;
+  UINT8   Device;
+  UINT8   Function;
+  UINT8   Offset;
+  UINT16  VendorId;
+  UINT16  DeviceId;
+  UINT16  SubsystemVendorId;
+  UINT16  SubsystemId;
+  UINT8   RevisionId;
+  UINT8   HeaderType;
+  UINT8   ClassCode[3];
+  UINT8   Reserved[3];
+  UINT32  BarLengthValue;
+} EDKII_PCI_BAR_PROBE_CACHE_ENTRY;
+
+//
+// Content of the variable.
+//
+typedef struct {
+  UINT32                            Version;
+  UINT32                            EntryCount;
+//EDKII_PCI_BAR_PROBE_CACHE_ENTRY   Entry[EntryCount];
+} EDKII_PCI_BAR_PROBE_CACHE;
+
+extern EFI_GUID gEdkiiPciBarProbeCacheGuid;
+
+#endif
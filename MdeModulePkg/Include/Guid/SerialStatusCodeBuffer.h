@@ -0,0 +1,44 @@
+/** @file
+  Serial status code buffer definitions.
+
+  With PcdStatusCodeSerialBufferSize set, the DXE status code handler driver
+  appends the messages it would write to the serial device to a ring buffer
+  and sends them from a timer event. The ring buffer is installed as a
+  configuration table so the last messages can be read after a hang.
+
+  Copyright (c) 2026, agent <agent@local>. All rights reserved.<BR>
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#ifndef _SERIAL_STATUS_CODE_BUFFER_H_
+#define _SERIAL_STATUS_CODE_BUFFER_H_
+
+#define EDKII_SERIAL_STATUS_CODE_BUFFER_GUID { \
+  0xe9816802, 0x46f7, 0x4491, { 0xb4, 0x88, 0x54, 0x55, 0x95, 0xdc, 0x23, 0x4b } \
+};
+
+//
+// Header of the ring buffer. The byte at offset N of the message stream is
+// stored at offset (N & (BufferSize - 1)) of Buffer. Both counters wrap around
+// at 4GB. The bytes from DrainedBytes to WrittenBytes have not been sent to
+// the serial device yet; the last MIN (WrittenBytes, BufferSize) bytes before
+// WrittenBytes are the most recent messages.
+//
+typedef struct {
+  UINT32                            BufferSize;
+  UINT32                            WrittenBytes;
+  UINT32                            DrainedBytes;
+  UINT32                            Reserved;
+//UINT8                             Buffer[BufferSize];
+} EDKII_SERIAL_STATUS_CODE_BUFFER;
+
+extern EFI_GUID gEdkiiSerialStatusCodeBufferGuid;
+
+#endif
@@ -321,6 +321,123 @@ FrameBufferBltLibVideoFill (
   return RETURN_SUCCESS;
 }
 
+/**
+  Convert a line of pixels read from the frame buffer to BLT pixels.
+
+  The common 32-bit RGB format only differs from the BLT format in the order
+  of the red and blue bytes, so it is converted with constant masks that the
+  compiler can unroll and vectorize. Other formats use the shifts and masks
+  computed by FrameBufferBltLibConfigurePixelFormat ().
+
+  @param[in]  Configure     Pointer to a configuration which was successfully
+                            created by FrameBufferBltConfigure ().
+  @param[out] Blt           The BLT pixels.
+  @param[in]  Source        The pixels in the frame buffer format.
+  @param[in]  Width         Number of pixels to convert.
+**/
+VOID
+FrameBufferBltLibConvertToBlt (
+  IN  FRAME_BUFFER_CONFIGURE                *Configure,
+  OUT EFI_GRAPHICS_OUTPUT_BLT_PIXEL         *Blt,
+  IN  CONST UINT8                           *Source,
+  IN  UINTN                                 Width
+  )
+{
+  UINT32                                    *Destination;
+  UINTN                                     BytesPerPixel;
+  UINT32                                    RedMask;
+  UINT32                                    GreenMask;
+  UINT32                                    BlueMask;
+  INT8                                      PixelShl[3];
+  INT8                                      PixelShr[3];
+  UINT32                                    Uint32;
+
+  Destination = (UINT32 *) Blt;
+
+  if (Configure->PixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+    for (; Width > 0; Width--, Source += sizeof (UINT32)) {
+      Uint32 = *(CONST UINT32 *) Source;
+      *Destination++ = (Uint32 & 0x0000ff00) |
+                       ((Uint32 >> 16) & 0x000000ff) |
+                       ((Uint32 << 16) & 0x00ff0000);
+    }
+    return;
+  }
+
+  BytesPerPixel = Configure->BytesPerPixel;
+  RedMask       = Configure->PixelMasks.RedMask;
+  GreenMask     = Configure->PixelMasks.GreenMask;
+  BlueMask      = Configure->PixelMasks.BlueMask;
+  CopyMem (PixelShl, Configure->PixelShl, sizeof (PixelShl));
+  CopyMem (PixelShr, Configure->PixelShr, sizeof (PixelShr));
+
+  for (; Width > 0; Width--, Source += BytesPerPixel) {
+    Uint32 = *(CONST UINT32 *) Source;
+    *Destination++ =
+      (UINT32) (
+        (((Uint32 & RedMask)   >> PixelShl[0]) << PixelShr[0]) |
+        (((Uint32 & GreenMask) >> PixelShl[1]) << PixelShr[1]) |
+        (((Uint32 & BlueMask)  >> PixelShl[2]) << PixelShr[2])
+        );
+  }
+}
+
+/**
+  Convert a line of BLT pixels to the frame buffer format.
+
+  @param[in]  Configure     Pointer to a configuration which was successfully
+                            created by FrameBufferBltConfigure ().
+  @param[out] Destination   The pixels in the frame buffer format.
+  @param[in]  Blt           The BLT pixels.
+  @param[in]  Width         Number of pixels to convert.
+**/
+VOID
+FrameBufferBltLibConvertToVideo (
+  IN  FRAME_BUFFER_CONFIGURE                *Configure,
+  OUT UINT8                                 *Destination,
+  IN  CONST EFI_GRAPHICS_OUTPUT_BLT_PIXEL   *Blt,
+  IN  UINTN                                 Width
+  )
+{
+  CONST UINT32                              *Source;
+  UINTN                                     BytesPerPixel;
+  UINT32                                    RedMask;
+  UINT32                                    GreenMask;
+  UINT32                                    BlueMask;
+  INT8                                      PixelShl[3];
+  INT8                                      PixelShr[3];
+  UINT32                                    Uint32;
+
+  Source = (CONST UINT32 *) Blt;
+
+  if (Configure->PixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+    for (; Width > 0; Width--, Destination += sizeof (UINT32)) {
+      Uint32 = *Source++;
+      *(UINT32 *) Destination = (Uint32 & 0x0000ff00) |
+                                ((Uint32 >> 16) & 0x000000ff) |
+                                ((Uint32 << 16) & 0x00ff0000);
+    }
+    return;
+  }
+
+  BytesPerPixel = Configure->BytesPerPixel;
+  RedMask       = Configure->PixelMasks.RedMask;
+  GreenMask     = Configure->PixelMasks.GreenMask;
+  BlueMask      = Configure->PixelMasks.BlueMask;
+  CopyMem (PixelShl, Configure->PixelShl, sizeof (PixelShl));
+  CopyMem (PixelShr, Configure->PixelShr, sizeof (PixelShr));
+
+  for (; Width > 0; Width--, Destination += BytesPerPixel) {
+    Uint32 = *Source++;
+    *(UINT32 *) Destination =
+      (UINT32) (
+        (((Uint32 << PixelShl[0]) >> PixelShr[0]) & RedMask) |
+        (((Uint32 << PixelShl[1]) >> PixelShr[1]) & GreenMask) |
+        (((Uint32 << PixelShl[2]) >> PixelShr[2]) & BlueMask)
+        );
+  }
+}
+
 /**
   Performs a UEFI Graphics Output Protocol Blt Video to Buffer operation
   with extended parameters.
@@ -354,11 +471,8 @@ FrameBufferBltLibVideoToBltBuffer (
 {
   UINTN                                  DstY;
   UINTN                                  SrcY;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL          *Blt;
   UINT8                                  *Source;
   UINT8                                  *Destination;
-  UINTN                                  IndexX;
-  UINT32                                 Uint32;
   UINTN                                  Offset;
   UINTN                                  WidthInBytes;
 
@@ -388,6 +502,19 @@ FrameBufferBltLibVideoToBltBuffer (
 
   WidthInBytes = Width * Configure->BytesPerPixel;
 
+  Offset = (SourceY * Configure->WidthInPixels) + SourceX;
+  Offset = Configure->BytesPerPixel * Offset;
+  Source = Configure->FrameBuffer + Offset;
+  Destination = (UINT8 *) BltBuffer + (DestinationY * Delta) +
+                (DestinationX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+
+  if ((Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) &&
+      (Width == Configure->WidthInPixels) && (Delta == WidthInBytes)) {
+    DEBUG ((EFI_D_VERBOSE, "VideoToBltBuffer (one-shot)\n"));
+    CopyMem (Destination, Source, WidthInBytes * Height);
+    return RETURN_SUCCESS;
+  }
+
   //
   // Video to BltBuffer: Source is Video, destination is BltBuffer
   //
@@ -395,35 +522,24 @@ FrameBufferBltLibVideoToBltBuffer (
        DstY < (Height + DestinationY);
        SrcY++, DstY++) {
 
-    Offset = (SrcY * Configure->WidthInPixels) + SourceX;
-    Offset = Configure->BytesPerPixel * Offset;
-    Source = Configure->FrameBuffer + Offset;
-
     if (Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
-      Destination = (UINT8 *) BltBuffer + (DstY * Delta) + (DestinationX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      CopyMem (Destination, Source, WidthInBytes);
     } else {
-      Destination = Configure->LineBuffer;
+      //
+      // Read the whole line from the frame buffer at once, reads of video
+      // memory are much slower than reads of system memory.
+      //
+      CopyMem (Configure->LineBuffer, Source, WidthInBytes);
+      FrameBufferBltLibConvertToBlt (
+        Configure,
+        (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *) Destination,
+        Configure->LineBuffer,
+        Width
+        );
     }
 
-    CopyMem (Destination, Source, WidthInBytes);
-
-    if (Configure->PixelFormat != PixelBlueGreenRedReserved8BitPerColor) {
-      for (IndexX = 0; IndexX < Width; IndexX++) {
-        Blt = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)
-          ((UINT8 *) BltBuffer + (DstY * Delta) +
-          (DestinationX + IndexX) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-        Uint32 = *(UINT32*) (Configure->LineBuffer + (IndexX * Configure->BytesPerPixel));
-        *(UINT32*) Blt =
-          (UINT32) (
-          (((Uint32 & Configure->PixelMasks.RedMask) >>
-            Configure->PixelShl[0]) << Configure->PixelShr[0]) |
-            (((Uint32 & Configure->PixelMasks.GreenMask) >>
-              Configure->PixelShl[1]) << Configure->PixelShr[1]) |
-              (((Uint32 & Configure->PixelMasks.BlueMask) >>
-                Configure->PixelShl[2]) << Configure->PixelShr[2])
-            );
-      }
-    }
+    Source      += Configure->WidthInBytes;
+    Destination += Delta;
   }
 
   return RETURN_SUCCESS;
@@ -462,11 +578,8 @@ FrameBufferBltLibBufferToVideo (
 {
   UINTN                                    DstY;
   UINTN                                    SrcY;
-  EFI_GRAPHICS_OUTPUT_BLT_PIXEL            *Blt;
   UINT8                                    *Source;
   UINT8                                    *Destination;
-  UINTN                                    IndexX;
-  UINT32                                   Uint32;
   UINTN                                    Offset;
   UINTN                                    WidthInBytes;
 
@@ -496,39 +609,41 @@ FrameBufferBltLibBufferToVideo (
 
   WidthInBytes = Width * Configure->BytesPerPixel;
 
+  Offset = (DestinationY * Configure->WidthInPixels) + DestinationX;
+  Offset = Configure->BytesPerPixel * Offset;
+  Destination = Configure->FrameBuffer + Offset;
+  Source = (UINT8 *) BltBuffer + (SourceY * Delta) +
+           (SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+
+  if ((Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) &&
+      (Width == Configure->WidthInPixels) && (Delta == WidthInBytes)) {
+    DEBUG ((EFI_D_VERBOSE, "BufferToVideo (one-shot)\n"));
+    CopyMem (Destination, Source, WidthInBytes * Height);
+    return RETURN_SUCCESS;
+  }
+
   for (SrcY = SourceY, DstY = DestinationY;
        SrcY < (Height + SourceY);
        SrcY++, DstY++) {
 
-    Offset = (DstY * Configure->WidthInPixels) + DestinationX;
-    Offset = Configure->BytesPerPixel * Offset;
-    Destination = Configure->FrameBuffer + Offset;
-
     if (Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
-      Source = (UINT8 *) BltBuffer + (SrcY * Delta);
+      CopyMem (Destination, Source, WidthInBytes);
     } else {
-      for (IndexX = 0; IndexX < Width; IndexX++) {
-        Blt =
-          (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *) (
-              (UINT8 *) BltBuffer +
-              (SrcY * Delta) +
-              ((SourceX + IndexX) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL))
-            );
-        Uint32 = *(UINT32*) Blt;
-        *(UINT32*) (Configure->LineBuffer + (IndexX * Configure->BytesPerPixel)) =
-          (UINT32) (
-              (((Uint32 << Configure->PixelShl[0]) >> Configure->PixelShr[0]) &
-               Configure->PixelMasks.RedMask) |
-              (((Uint32 << Configure->PixelShl[1]) >> Configure->PixelShr[1]) &
-               Configure->PixelMasks.GreenMask) |
-              (((Uint32 << Configure->PixelShl[2]) >> Configure->PixelShr[2]) &
-               Configure->PixelMasks.BlueMask)
-            );
-      }
-      Source = Configure->LineBuffer;
+      //
+      // Convert the line in system memory and write it to the frame buffer
+      // at once, so a write-combining frame buffer sees sequential writes.
+      //
+      FrameBufferBltLibConvertToVideo (
+        Configure,
+        Configure->LineBuffer,
+        (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *) Source,
+        Width
+        );
+      CopyMem (Destination, Configure->LineBuffer, WidthInBytes);
     }
 
-    CopyMem (Destination, Source, WidthInBytes);
+    Source      += Delta;
+    Destination += Configure->WidthInBytes;
   }
 
   return RETURN_SUCCESS;
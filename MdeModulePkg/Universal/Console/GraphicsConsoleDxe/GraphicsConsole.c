@@ -59,6 +59,8 @@ EFI_HII_FONT_PROTOCOL       *mHiiFont;
 EFI_HII_HANDLE              mHiiHandle;
 VOID                        *mHiiRegistration;
 
+GLYPH_CACHE_ENTRY           *mGlyphCache = NULL;
+
 EFI_GUID             mFontPackageListGuid = {0xf5f219d3, 0x7006, 0x4648, {0xac, 0x8d, 0xd6, 0x1d, 0xfb, 0x7b, 0xc6, 0xad}};
 
 CHAR16               mCrLfString[3] = { CHAR_CARRIAGE_RETURN, CHAR_LINEFEED, CHAR_NULL };
@@ -1723,6 +1725,160 @@ GetTextColors (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the rendered narrow glyph of a character in the current text attribute
+  from the glyph cache, rendering it through the HII Font protocol if it is
+  not cached yet.
+
+  @param  This                  Protocol instance pointer.
+  @param  Character             The character to render.
+
+  @return The cache entry holding the glyph, or NULL if the character has no
+          glyph of the size of a narrow character cell.
+
+**/
+GLYPH_CACHE_ENTRY *
+GetCachedGlyph (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *This,
+  IN  CHAR16                           Character
+  )
+{
+  EFI_STATUS                        Status;
+  GLYPH_CACHE_ENTRY                 *Entry;
+  UINT8                             Attribute;
+  CHAR16                            String[2];
+  EFI_FONT_DISPLAY_INFO             FontInfo;
+  EFI_IMAGE_OUTPUT                  Image;
+  EFI_IMAGE_OUTPUT                  *Blt;
+  EFI_HII_ROW_INFO                  *RowInfoArray;
+  UINTN                             RowInfoArraySize;
+
+  if (mGlyphCache == NULL) {
+    mGlyphCache = AllocateZeroPool (GLYPH_CACHE_SIZE * sizeof (GLYPH_CACHE_ENTRY));
+    if (mGlyphCache == NULL) {
+      return NULL;
+    }
+  }
+
+  Attribute = (UINT8) (This->Mode->Attribute & 0x7F);
+  Entry     = &mGlyphCache[(Character ^ (Attribute * 0x9E)) % GLYPH_CACHE_SIZE];
+  if (Entry->Valid && Entry->Character == Character && Entry->Attribute == Attribute) {
+    return Entry;
+  }
+
+  Entry->Valid     = FALSE;
+  Entry->Character = Character;
+  Entry->Attribute = Attribute;
+
+  String[0] = Character;
+  String[1] = CHAR_NULL;
+
+  ZeroMem (&FontInfo, sizeof (FontInfo));
+  GetTextColors (This, &FontInfo.ForegroundColor, &FontInfo.BackgroundColor);
+
+  ZeroMem (&Image, sizeof (Image));
+  Image.Width        = EFI_GLYPH_WIDTH;
+  Image.Height       = EFI_GLYPH_HEIGHT;
+  Image.Image.Bitmap = Entry->Bitmap;
+  Blt                = &Image;
+
+  RowInfoArray     = NULL;
+  RowInfoArraySize = 0;
+  Status = mHiiFont->StringToImage (
+                       mHiiFont,
+                       EFI_HII_IGNORE_IF_NO_GLYPH | EFI_HII_IGNORE_LINE_BREAK,
+                       String,
+                       &FontInfo,
+                       &Blt,
+                       0,
+                       0,
+                       &RowInfoArray,
+                       &RowInfoArraySize,
+                       NULL
+                       );
+  if (!EFI_ERROR (Status) &&
+      RowInfoArraySize == 1 &&
+      RowInfoArray[0].LineWidth == EFI_GLYPH_WIDTH &&
+      RowInfoArray[0].LineHeight == EFI_GLYPH_HEIGHT) {
+    Entry->Valid = TRUE;
+  }
+
+  if (RowInfoArray != NULL) {
+    FreePool (RowInfoArray);
+  }
+
+  return Entry->Valid ? Entry : NULL;
+}
+
+/**
+  Draw a run of narrow characters with Graphics Output protocol from the
+  glyph cache, composing the whole run in the line buffer and writing it
+  to the screen with a single Blt.
+
+  @param  This                  Protocol instance pointer.
+  @param  UnicodeWeight         One Unicode string to be displayed.
+  @param  Count                 The count of Unicode string.
+
+  @retval EFI_SUCCESS           The run was drawn.
+  @retval EFI_UNSUPPORTED       The run can not be drawn from the glyph cache.
+  @retval Others                The Blt to the screen failed.
+
+**/
+EFI_STATUS
+DrawCachedGlyphsAtCursorN (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *This,
+  IN  CHAR16                           *UnicodeWeight,
+  IN  UINTN                            Count
+  )
+{
+  GRAPHICS_CONSOLE_DEV              *Private;
+  GLYPH_CACHE_ENTRY                 *Entry;
+  UINTN                             Index;
+  UINTN                             Row;
+  UINTN                             Delta;
+
+  Private = GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS (This);
+
+  if (Private->GraphicsOutput == NULL || Private->LineBuffer == NULL || Count == 0 ||
+      Count > Private->ModeData[This->Mode->Mode].Columns ||
+      (This->Mode->Attribute & EFI_WIDE_ATTRIBUTE) != 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Copy each glyph into the line buffer as soon as it is found; a later
+  // character of the run may evict it from the cache.
+  //
+  Delta = Count * EFI_GLYPH_WIDTH;
+  for (Index = 0; Index < Count; Index++) {
+    Entry = GetCachedGlyph (This, UnicodeWeight[Index]);
+    if (Entry == NULL) {
+      return EFI_UNSUPPORTED;
+    }
+
+    for (Row = 0; Row < EFI_GLYPH_HEIGHT; Row++) {
+      CopyMem (
+        &Private->LineBuffer[Row * Delta + Index * EFI_GLYPH_WIDTH],
+        &Entry->Bitmap[Row * EFI_GLYPH_WIDTH],
+        EFI_GLYPH_WIDTH * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+        );
+    }
+  }
+
+  return Private->GraphicsOutput->Blt (
+                                    Private->GraphicsOutput,
+                                    Private->LineBuffer,
+                                    EfiBltBufferToVideo,
+                                    0,
+                                    0,
+                                    This->Mode->CursorColumn * EFI_GLYPH_WIDTH + Private->ModeData[This->Mode->Mode].DeltaX,
+                                    This->Mode->CursorRow * EFI_GLYPH_HEIGHT + Private->ModeData[This->Mode->Mode].DeltaY,
+                                    Delta,
+                                    EFI_GLYPH_HEIGHT,
+                                    Delta * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                                    );
+}
+
 /**
   Draw Unicode string on the Graphics Console device's screen.
 
@@ -1752,6 +1908,14 @@ DrawUnicodeWeightAtCursorN (
   EFI_HII_ROW_INFO                  *RowInfoArray;
   UINTN                             RowInfoArraySize;
 
+  //
+  // Narrow characters are drawn from pre-rendered glyphs when possible.
+  //
+  Status = DrawCachedGlyphsAtCursorN (This, UnicodeWeight, Count);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
   Private = GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS (This);
   Blt = (EFI_IMAGE_OUTPUT *) AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
   if (Blt == NULL) {
@@ -48,6 +48,19 @@ typedef union {
   EFI_WIDE_GLYPH    WideGlyph;
 } GLYPH_UNION;
 
+//
+// Rendered narrow glyph of a character in a text attribute. The cache is
+// direct mapped, indexed by a hash of the character and the attribute.
+//
+#define GLYPH_CACHE_SIZE  256
+
+typedef struct {
+  CHAR16                          Character;
+  UINT8                           Attribute;
+  BOOLEAN                         Valid;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL   Bitmap[EFI_GLYPH_WIDTH * EFI_GLYPH_HEIGHT];
+} GLYPH_CACHE_ENTRY;
+
 //
 // Device Structure
 //
@@ -46,6 +46,12 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define RAW_FIFO_MAX_NUMBER 256
 #define FIFO_MAX_NUMBER     128
 
+//
+// Size of the buffer that collects the bytes of one OutputString() call
+// before they are written to the serial device.
+//
+#define TERMINAL_OUTPUT_BUFFER_SIZE  256
+
 typedef struct {
   UINT8 Head;
   UINT8 Tail;
@@ -124,6 +130,8 @@ typedef struct {
   EFI_SIMPLE_TEXT_INPUT_EX_PROTOCOL   SimpleInputEx;
   LIST_ENTRY                          NotifyList;
   EFI_EVENT                           KeyNotifyProcessEvent;
+  UINTN                               OutputBufferLength;
+  UINT8                               OutputBuffer[TERMINAL_OUTPUT_BUFFER_SIZE];
 } TERMINAL_DEV;
 
 #define INPUT_STATE_DEFAULT               0x00
@@ -1397,6 +1405,42 @@ TerminalIsValidEfiCntlChar (
   IN  CHAR16  CharC
   );
 
+/**
+  Write the bytes collected in the output buffer of the terminal to the
+  serial device.
+
+  @param  TerminalDevice        The terminal device.
+
+  @retval EFI_SUCCESS           The buffer is written and emptied.
+  @retval Others                The serial device failed to write the buffer.
+                                The buffer is emptied.
+
+**/
+EFI_STATUS
+TerminalFlushOutput (
+  IN  TERMINAL_DEV  *TerminalDevice
+  );
+
+/**
+  Append bytes to the output buffer of the terminal, flushing it first if
+  they do not fit.
+
+  @param  TerminalDevice        The terminal device.
+  @param  Data                  The bytes to output.
+  @param  Length                Number of bytes to output, no more than
+                                TERMINAL_OUTPUT_BUFFER_SIZE.
+
+  @retval EFI_SUCCESS           The bytes are buffered.
+  @retval Others                The serial device failed to write the buffer.
+
+**/
+EFI_STATUS
+TerminalBufferOutput (
+  IN  TERMINAL_DEV  *TerminalDevice,
+  IN  VOID          *Data,
+  IN  UINTN         Length
+  );
+
 /**
   Check if the device supports hot-plug through its device path.
 
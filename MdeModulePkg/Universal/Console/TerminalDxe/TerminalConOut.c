@@ -86,6 +86,73 @@ CHAR16 mSetCursorPositionString[]  = { ESC, '[', '0', '0', ';', '0', '0', 'H', 0
 CHAR16 mCursorForwardString[]      = { ESC, '[', '0', '0', 'C', 0 };
 CHAR16 mCursorBackwardString[]     = { ESC, '[', '0', '0', 'D', 0 };
 
+/**
+  Write the bytes collected in the output buffer of the terminal to the
+  serial device.
+
+  @param  TerminalDevice        The terminal device.
+
+  @retval EFI_SUCCESS           The buffer is written and emptied.
+  @retval Others                The serial device failed to write the buffer.
+                                The buffer is emptied.
+
+**/
+EFI_STATUS
+TerminalFlushOutput (
+  IN  TERMINAL_DEV  *TerminalDevice
+  )
+{
+  UINTN       Length;
+
+  Length = TerminalDevice->OutputBufferLength;
+  if (Length == 0) {
+    return EFI_SUCCESS;
+  }
+
+  TerminalDevice->OutputBufferLength = 0;
+  return TerminalDevice->SerialIo->Write (
+                                     TerminalDevice->SerialIo,
+                                     &Length,
+                                     TerminalDevice->OutputBuffer
+                                     );
+}
+
+/**
+  Append bytes to the output buffer of the terminal, flushing it first if
+  they do not fit.
+
+  @param  TerminalDevice        The terminal device.
+  @param  Data                  The bytes to output.
+  @param  Length                Number of bytes to output, no more than
+                                TERMINAL_OUTPUT_BUFFER_SIZE.
+
+  @retval EFI_SUCCESS           The bytes are buffered.
+  @retval Others                The serial device failed to write the buffer.
+
+**/
+EFI_STATUS
+TerminalBufferOutput (
+  IN  TERMINAL_DEV  *TerminalDevice,
+  IN  VOID          *Data,
+  IN  UINTN         Length
+  )
+{
+  EFI_STATUS  Status;
+
+  ASSERT (Length <= TERMINAL_OUTPUT_BUFFER_SIZE);
+
+  if (TerminalDevice->OutputBufferLength + Length > TERMINAL_OUTPUT_BUFFER_SIZE) {
+    Status = TerminalFlushOutput (TerminalDevice);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  CopyMem (TerminalDevice->OutputBuffer + TerminalDevice->OutputBufferLength, Data, Length);
+  TerminalDevice->OutputBufferLength += Length;
+  return EFI_SUCCESS;
+}
+
 //
 // Body of the ConOut functions
 //
@@ -182,7 +249,6 @@ TerminalConOutOutputString (
   EFI_SIMPLE_TEXT_OUTPUT_MODE *Mode;
   UINTN                       MaxColumn;
   UINTN                       MaxRow;
-  UINTN                       Length;
   UTF8_CHAR                   Utf8Char;
   CHAR8                       GraphicChar;
   CHAR8                       AsciiChar;
@@ -257,13 +323,7 @@ TerminalConOutOutputString (
         GraphicChar = AsciiChar;
       }
 
-      Length = 1;
-
-      Status = TerminalDevice->SerialIo->Write (
-                                          TerminalDevice->SerialIo,
-                                          &Length,
-                                          &GraphicChar
-                                          );
+      Status = TerminalBufferOutput (TerminalDevice, &GraphicChar, 1);
 
       if (EFI_ERROR (Status)) {
         goto OutputError;
@@ -273,12 +333,7 @@ TerminalConOutOutputString (
 
     case TerminalTypeVtUtf8:
       UnicodeToUtf8 (*WString, &Utf8Char, &ValidBytes);
-      Length = ValidBytes;
-      Status = TerminalDevice->SerialIo->Write (
-                                          TerminalDevice->SerialIo,
-                                          &Length,
-                                          (UINT8 *) &Utf8Char
-                                          );
+      Status = TerminalBufferOutput (TerminalDevice, &Utf8Char, ValidBytes);
       if (EFI_ERROR (Status)) {
         goto OutputError;
       }
@@ -330,13 +385,7 @@ TerminalConOutOutputString (
           CrLfStr[0] = '\r';
           CrLfStr[1] = '\n';
 
-          Length = sizeof(CrLfStr);
-
-          Status = TerminalDevice->SerialIo->Write (
-                                                TerminalDevice->SerialIo,
-                                                &Length,
-                                                CrLfStr
-                                                );
+          Status = TerminalBufferOutput (TerminalDevice, CrLfStr, sizeof (CrLfStr));
 
           if (EFI_ERROR (Status)) {
             goto OutputError;
@@ -349,6 +398,14 @@ TerminalConOutOutputString (
 
   }
 
+  //
+  // Write the whole string to the serial device at once.
+  //
+  Status = TerminalFlushOutput (TerminalDevice);
+  if (EFI_ERROR (Status)) {
+    goto OutputError;
+  }
+
   if (Warning) {
     return EFI_WARN_UNKNOWN_GLYPH;
   }
@@ -356,6 +413,8 @@ TerminalConOutOutputString (
   return EFI_SUCCESS;
 
 OutputError:
+  TerminalDevice->OutputBufferLength = 0;
+
   REPORT_STATUS_CODE_WITH_DEVICE_PATH (
     EFI_ERROR_CODE | EFI_ERROR_MINOR,
     (EFI_PERIPHERAL_REMOTE_CONSOLE | EFI_P_EC_OUTPUT_ERROR),
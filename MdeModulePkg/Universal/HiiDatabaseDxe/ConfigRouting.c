@@ -16,6 +16,8 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include "HiiDatabase.h"
 extern HII_DATABASE_PRIVATE_DATA mPrivate;
 
+CONST CHAR16 mHexDigits[] = L"0123456789abcdef";
+
 /**
   Calculate the number of Unicode characters of the incoming Configuration string,
   not including NULL terminator.
@@ -389,60 +391,181 @@ OutputConfigBody (
 }
 
 /**
-  Append a string to a multi-string format.
+  Initialize a string builder with an empty string of MAX_STRING_LENGTH bytes.
 
   This is a internal function.
 
-  @param  MultiString            String in <MultiConfigRequest>,
-                                 <MultiConfigAltResp>, or <MultiConfigResp>. On
-                                 input, the buffer length of  this string is
-                                 MAX_STRING_LENGTH. On output, the  buffer length
-                                 might be updated.
-  @param  AppendString           NULL-terminated Unicode string.
+  @param  Builder                The string builder to initialize. The caller
+                                 takes the ownership of Builder->String.
 
-  @retval EFI_INVALID_PARAMETER  Any incoming parameter is invalid.
-  @retval EFI_SUCCESS            AppendString is append to the end of MultiString
+  @retval EFI_OUT_OF_RESOURCES   Insufficient resources to allocate the string.
+  @retval EFI_SUCCESS            The string builder is initialized.
 
 **/
 EFI_STATUS
-AppendToMultiString (
-  IN OUT EFI_STRING                *MultiString,
-  IN EFI_STRING                    AppendString
+InitConfigStringBuilder (
+  OUT HII_CONFIG_STRING_BUILDER    *Builder
   )
 {
-  UINTN AppendStringSize;
-  UINTN MultiStringSize;
-  UINTN MaxLen;
+  Builder->String = (EFI_STRING) AllocateZeroPool (MAX_STRING_LENGTH);
+  if (Builder->String == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
 
-  if (MultiString == NULL || *MultiString == NULL || AppendString == NULL) {
-    return EFI_INVALID_PARAMETER;
+  Builder->Length    = 0;
+  Builder->MaxLength = MAX_STRING_LENGTH / sizeof (CHAR16);
+  return EFI_SUCCESS;
+}
+
+/**
+  Make sure a string builder has room for more characters.
+
+  The buffer is doubled until it is large enough, so building a string of N
+  characters copies it O(log N) times.
+
+  This is a internal function.
+
+  @param  Builder                The string builder.
+  @param  Length                 Number of characters to be appended.
+
+  @retval EFI_OUT_OF_RESOURCES   Insufficient resources to enlarge the string.
+                                 The string is not changed.
+  @retval EFI_SUCCESS            Length characters can be appended.
+
+**/
+EFI_STATUS
+GrowConfigStringBuilder (
+  IN OUT HII_CONFIG_STRING_BUILDER *Builder,
+  IN UINTN                         Length
+  )
+{
+  UINTN                            MaxLength;
+  EFI_STRING                       String;
+
+  MaxLength = Builder->MaxLength;
+  while (Builder->Length + Length + 1 > MaxLength) {
+    MaxLength *= 2;
+  }
+
+  if (MaxLength != Builder->MaxLength) {
+    String = (EFI_STRING) ReallocatePool (
+                            Builder->MaxLength * sizeof (CHAR16),
+                            MaxLength * sizeof (CHAR16),
+                            Builder->String
+                            );
+    if (String == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Builder->String    = String;
+    Builder->MaxLength = MaxLength;
   }
 
-  AppendStringSize = StrSize (AppendString);
-  MultiStringSize  = StrSize (*MultiString);
-  MaxLen = MAX_STRING_LENGTH / sizeof (CHAR16);
+  return EFI_SUCCESS;
+}
 
-  //
-  // Enlarge the buffer each time when length exceeds MAX_STRING_LENGTH.
-  //
-  if (MultiStringSize + AppendStringSize > MAX_STRING_LENGTH ||
-      MultiStringSize > MAX_STRING_LENGTH) {
-    *MultiString = (EFI_STRING) ReallocatePool (
-                                  MultiStringSize,
-                                  MultiStringSize + AppendStringSize,
-                                  (VOID *) (*MultiString)
-                                  );
-    MaxLen = (MultiStringSize + AppendStringSize) / sizeof (CHAR16);
-    ASSERT (*MultiString != NULL);
+/**
+  Append characters to a string builder.
+
+  This is a internal function.
+
+  @param  Builder                The string builder.
+  @param  AppendString           The characters to append. They need not be
+                                 null terminated.
+  @param  Length                 Number of characters to append.
+
+  @retval EFI_OUT_OF_RESOURCES   Insufficient resources to enlarge the string.
+  @retval EFI_SUCCESS            The characters are appended.
+
+**/
+EFI_STATUS
+AppendToConfigStringBuilder (
+  IN OUT HII_CONFIG_STRING_BUILDER *Builder,
+  IN CONST CHAR16                  *AppendString,
+  IN UINTN                         Length
+  )
+{
+  EFI_STATUS                       Status;
+
+  Status = GrowConfigStringBuilder (Builder, Length);
+  if (EFI_ERROR (Status)) {
+    return Status;
   }
-  //
-  // Append the incoming string
-  //
-  StrCatS (*MultiString, MaxLen, AppendString);
 
+  CopyMem (Builder->String + Builder->Length, AppendString, Length * sizeof (CHAR16));
+  Builder->Length += Length;
+  Builder->String[Builder->Length] = L'\0';
+  return EFI_SUCCESS;
+}
+
+/**
+  Append a buffer to a string builder as a <Number>, i.e. in hex from the
+  most significant byte to the least significant one.
+
+  This is a internal function.
+
+  @param  Builder                The string builder.
+  @param  Buffer                 The buffer to convert.
+  @param  BufferSize             The size of Buffer in bytes.
+
+  @retval EFI_OUT_OF_RESOURCES   Insufficient resources to enlarge the string.
+  @retval EFI_SUCCESS            The buffer is appended.
+
+**/
+EFI_STATUS
+AppendHexToConfigStringBuilder (
+  IN OUT HII_CONFIG_STRING_BUILDER *Builder,
+  IN CONST UINT8                   *Buffer,
+  IN UINTN                         BufferSize
+  )
+{
+  EFI_STATUS                       Status;
+  EFI_STRING                       String;
+  CONST UINT8                      *Byte;
+
+  Status = GrowConfigStringBuilder (Builder, BufferSize * 2);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  String = Builder->String + Builder->Length;
+  for (Byte = Buffer + BufferSize; Byte > Buffer; ) {
+    Byte--;
+    *String++ = mHexDigits[*Byte >> 4];
+    *String++ = mHexDigits[*Byte & 0xF];
+  }
+  *String = L'\0';
+
+  Builder->Length += BufferSize * 2;
   return EFI_SUCCESS;
 }
 
+/**
+  Get the value of a hex digit.
+
+  This is a internal function.
+
+  @param  Char                   The character to convert.
+
+  @return The value of the digit, or 0 if Char is not a hex digit.
+
+**/
+UINT8
+HexCharToUint8 (
+  IN CHAR16                        Char
+  )
+{
+  if (Char >= L'0' && Char <= L'9') {
+    return (UINT8) (Char - L'0');
+  }
+  if (Char >= L'a' && Char <= L'f') {
+    return (UINT8) (Char - L'a' + 10);
+  }
+  if (Char >= L'A' && Char <= L'F') {
+    return (UINT8) (Char - L'A' + 10);
+  }
+  return 0;
+}
+
 
 /**
   Get the value of <Number> in <BlockConfig> format, i.e. the value of OFFSET
@@ -472,46 +595,31 @@ GetValueOfNumber (
 {
   EFI_STRING               TmpPtr;
   UINTN                    Length;
-  EFI_STRING               Str;
   UINT8                    *Buf;
-  EFI_STATUS               Status;
   UINT8                    DigitUint8;
   UINTN                    Index;
-  CHAR16                   TemStr[2];
 
   if (StringPtr == NULL || *StringPtr == L'\0' || Number == NULL || Len == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  Buf = NULL;
-
   TmpPtr = StringPtr;
   while (*StringPtr != L'\0' && *StringPtr != L'&') {
     StringPtr++;
   }
   *Len   = StringPtr - TmpPtr;
-  Length = *Len + 1;
-
-  Str = (EFI_STRING) AllocateZeroPool (Length * sizeof (CHAR16));
-  if (Str == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
-  }
-  CopyMem (Str, TmpPtr, *Len * sizeof (CHAR16));
-  *(Str + *Len) = L'\0';
+  Length = *Len;
 
-  Length = (Length + 1) / 2;
-  Buf = (UINT8 *) AllocateZeroPool (Length);
+  Buf = (UINT8 *) AllocateZeroPool ((Length + 2) / 2);
   if (Buf == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Exit;
+    return EFI_OUT_OF_RESOURCES;
   }
-  
-  Length = *Len;
-  ZeroMem (TemStr, sizeof (TemStr));
+
+  //
+  // Convert the digits in place, from the least significant one.
+  //
   for (Index = 0; Index < Length; Index ++) {
-    TemStr[0] = Str[Length - Index - 1];
-    DigitUint8 = (UINT8) StrHexToUint64 (TemStr);
+    DigitUint8 = HexCharToUint8 (TmpPtr[Length - Index - 1]);
     if ((Index & 1) == 0) {
       Buf [Index/2] = DigitUint8;
     } else {
@@ -520,14 +628,46 @@ GetValueOfNumber (
   }
 
   *Number = Buf;
-  Status  = EFI_SUCCESS;
+  return EFI_SUCCESS;
+}
 
-Exit:
-  if (Str != NULL) {
-    FreePool (Str);
+/**
+  Get the value of a <Number> that fits in a UINTN, i.e. the value of OFFSET
+  or WIDTH, without allocating memory for it.
+
+  This is a internal function.
+
+  @param  StringPtr              String in <BlockConfig> format and points to the
+                                 first character of <Number>.
+  @param  Number                 The output value. Only the least significant
+                                 bytes are kept if it does not fit in a UINTN.
+  @param  Len                    Length of the <Number>, in characters.
+
+  @retval EFI_INVALID_PARAMETER  Any incoming parameter is invalid.
+  @retval EFI_SUCCESS            Value of <Number> is outputted in Number
+                                 successfully.
+
+**/
+EFI_STATUS
+GetUintnValueOfNumber (
+  IN EFI_STRING                    StringPtr,
+  OUT UINTN                        *Number,
+  OUT UINTN                        *Len
+  )
+{
+  EFI_STRING               TmpPtr;
+
+  if (StringPtr == NULL || *StringPtr == L'\0' || Number == NULL || Len == NULL) {
+    return EFI_INVALID_PARAMETER;
   }
 
-  return Status;
+  *Number = 0;
+  for (TmpPtr = StringPtr; *TmpPtr != L'\0' && *TmpPtr != L'&'; TmpPtr++) {
+    *Number = (*Number << 4) | HexCharToUint8 (*TmpPtr);
+  }
+  *Len = TmpPtr - StringPtr;
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -4460,6 +4600,7 @@ HiiConfigRoutingExtractConfig (
   UINTN                               ConigStringSize;
   UINTN                               ConigStringSizeNewsize;
   EFI_STRING                          ConfigStringPtr;
+  HII_CONFIG_STRING_BUILDER           Builder;
 
   if (This == NULL || Progress == NULL || Results == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -4496,12 +4637,13 @@ HiiConfigRoutingExtractConfig (
   FirstElement = TRUE;
 
   //
-  // Allocate a fix length of memory to store Results. Reallocate memory for
-  // Results if this fix length is insufficient.
+  // Build Results in a string that grows geometrically, so attaching each
+  // <ConfigAltResp> does not rescan or copy what is already built.
   //
-  *Results = (EFI_STRING) AllocateZeroPool (MAX_STRING_LENGTH);
-  if (*Results == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  *Results = NULL;
+  Status = InitConfigStringBuilder (&Builder);
+  if (EFI_ERROR (Status)) {
+    return Status;
   }
 
   while (*StringPtr != 0 && StrnCmp (StringPtr, L"GUID=", StrLen (L"GUID=")) == 0) {
@@ -4740,11 +4882,11 @@ HiiConfigRoutingExtractConfig (
     
 NextConfigString:
     if (!FirstElement) {
-      Status = AppendToMultiString (Results, L"&");
+      Status = AppendToConfigStringBuilder (&Builder, L"&", 1);
       ASSERT_EFI_ERROR (Status);
     }
     
-    Status = AppendToMultiString (Results, AccessResults);
+    Status = AppendToConfigStringBuilder (&Builder, AccessResults, StrLen (AccessResults));
     ASSERT_EFI_ERROR (Status);
 
     FirstElement = FALSE;
@@ -4768,8 +4910,9 @@ NextConfigString:
 
 Done:
   if (EFI_ERROR (Status)) {
-    FreePool (*Results);
-    *Results = NULL;
+    FreePool (Builder.String);
+  } else {
+    *Results = Builder.String;
   }
   
   if (ConfigRequest != NULL) {
@@ -4840,6 +4983,7 @@ HiiConfigRoutingExportConfig (
   UINT8                               *DevicePathPkg;
   UINT8                               *CurrentDevicePath;
   BOOLEAN                             IfrDataParsedFlag;
+  HII_CONFIG_STRING_BUILDER           Builder;
 
   if (This == NULL || Results == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -4848,12 +4992,12 @@ HiiConfigRoutingExportConfig (
   Private = CONFIG_ROUTING_DATABASE_PRIVATE_DATA_FROM_THIS (This);
 
   //
-  // Allocate a fix length of memory to store Results. Reallocate memory for
-  // Results if this fix length is insufficient.
+  // Build Results in a string that grows geometrically, so attaching each
+  // <ConfigAltResp> does not rescan or copy what is already built.
   //
-  *Results = (EFI_STRING) AllocateZeroPool (MAX_STRING_LENGTH);
-  if (*Results == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  Status = InitConfigStringBuilder (&Builder);
+  if (EFI_ERROR (Status)) {
+    return Status;
   }
 
   NumberConfigAccessHandles = 0;
@@ -4865,6 +5009,7 @@ HiiConfigRoutingExportConfig (
              &ConfigAccessHandles
              );
   if (EFI_ERROR (Status)) {
+    FreePool (Builder.String);
     return Status;
   }
 
@@ -4972,11 +5117,11 @@ HiiConfigRoutingExportConfig (
       // which separates the first <ConfigAltResp> and the following ones.
       //
       if (!FirstElement) {
-        Status = AppendToMultiString (Results, L"&");
+        Status = AppendToConfigStringBuilder (&Builder, L"&", 1);
         ASSERT_EFI_ERROR (Status);
       }
       
-      Status = AppendToMultiString (Results, AccessResults);
+      Status = AppendToConfigStringBuilder (&Builder, AccessResults, StrLen (AccessResults));
       ASSERT_EFI_ERROR (Status);
 
       FirstElement = FALSE;
@@ -4987,6 +5132,7 @@ HiiConfigRoutingExportConfig (
   }
   FreePool (ConfigAccessHandles);
 
+  *Results = Builder.String;
   return EFI_SUCCESS;  
 }
 
@@ -5262,18 +5408,9 @@ HiiBlockToConfig (
   UINTN                               Length;
   EFI_STATUS                          Status;
   EFI_STRING                          TmpPtr;
-  UINT8                               *TmpBuffer;
   UINTN                               Offset;
   UINTN                               Width;
-  UINT8                               *Value;
-  EFI_STRING                          ValueStr;
-  EFI_STRING                          ConfigElement;
-  UINTN                               Index;
-  UINT8                               *TemBuffer;
-  CHAR16                              *TemString;
-  CHAR16                              TemChar;
-
-  TmpBuffer = NULL;
+  HII_CONFIG_STRING_BUILDER           Builder;
 
   if (This == NULL || Progress == NULL || Config == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -5288,18 +5425,16 @@ HiiBlockToConfig (
   Private = CONFIG_ROUTING_DATABASE_PRIVATE_DATA_FROM_THIS (This);
   ASSERT (Private != NULL);
 
-  StringPtr     = ConfigRequest;
-  ValueStr      = NULL;
-  Value         = NULL;
-  ConfigElement = NULL;
+  StringPtr = ConfigRequest;
+  *Config   = NULL;
 
   //
-  // Allocate a fix length of memory to store Results. Reallocate memory for
-  // Results if this fix length is insufficient.
+  // Build the results in a string that grows geometrically, each element is
+  // appended without rescanning or copying what is already built.
   //
-  *Config = (EFI_STRING) AllocateZeroPool (MAX_STRING_LENGTH);
-  if (*Config == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  Status = InitConfigStringBuilder (&Builder);
+  if (EFI_ERROR (Status)) {
+    return Status;
   }
 
   //
@@ -5322,26 +5457,21 @@ HiiBlockToConfig (
   while (*StringPtr != L'&' && *StringPtr != 0) {
     StringPtr++;
   }
-  if (*StringPtr == 0) {
-    *Progress = StringPtr;
-
-    AppendToMultiString(Config, ConfigRequest);
-    HiiToLower (*Config);
-
-    return EFI_SUCCESS;
+  if (*StringPtr != 0) {
+    //
+    // Skip '&'
+    //
+    StringPtr++;
   }
-  //
-  // Skip '&'
-  //
-  StringPtr++;
 
   //
   // Copy <ConfigHdr> and an additional '&' to <ConfigResp>
   //
-  TemChar = *StringPtr;
-  *StringPtr = '\0';
-  AppendToMultiString(Config, ConfigRequest);
-  *StringPtr = TemChar;
+  Status = AppendToConfigStringBuilder (&Builder, ConfigRequest, StringPtr - ConfigRequest);
+  if (EFI_ERROR (Status)) {
+    *Progress = ConfigRequest;
+    goto Exit;
+  }
 
   //
   // Parse each <RequestElement> if exists
@@ -5358,18 +5488,11 @@ HiiBlockToConfig (
     //
     // Get Offset
     //
-    Status = GetValueOfNumber (StringPtr, &TmpBuffer, &Length);
+    Status = GetUintnValueOfNumber (StringPtr, &Offset, &Length);
     if (EFI_ERROR (Status)) {
       *Progress = TmpPtr - 1;
       goto Exit;
     }
-    Offset = 0;
-    CopyMem (
-      &Offset,
-      TmpBuffer,
-      (((Length + 1) / 2) < sizeof (UINTN)) ? ((Length + 1) / 2) : sizeof (UINTN)
-      );
-    FreePool (TmpBuffer);
 
     StringPtr += Length;
     if (StrnCmp (StringPtr, L"&WIDTH=", StrLen (L"&WIDTH=")) != 0) {
@@ -5382,18 +5505,11 @@ HiiBlockToConfig (
     //
     // Get Width
     //
-    Status = GetValueOfNumber (StringPtr, &TmpBuffer, &Length);
+    Status = GetUintnValueOfNumber (StringPtr, &Width, &Length);
     if (EFI_ERROR (Status)) {
       *Progress =  TmpPtr - 1;
       goto Exit;
     }
-    Width = 0;
-    CopyMem (
-      &Width,
-      TmpBuffer,
-      (((Length + 1) / 2) < sizeof (UINTN)) ? ((Length + 1) / 2) : sizeof (UINTN)
-      );
-    FreePool (TmpBuffer);
 
     StringPtr += Length;
     if (*StringPtr != 0 && *StringPtr != L'&') {
@@ -5411,62 +5527,21 @@ HiiBlockToConfig (
       goto Exit;
     }
 
-    Value = (UINT8 *) AllocateZeroPool (Width);
-    if (Value == NULL) {
-      *Progress = ConfigRequest;
-      Status = EFI_OUT_OF_RESOURCES;
-      goto Exit;
-    }
-
-    CopyMem (Value, (UINT8 *) Block + Offset, Width);
-
-    Length = Width * 2 + 1;
-    ValueStr = (EFI_STRING) AllocateZeroPool (Length  * sizeof (CHAR16));
-    if (ValueStr == NULL) {
-      *Progress = ConfigRequest;
-      Status = EFI_OUT_OF_RESOURCES;
-      goto Exit;
-    }
-    
-    TemString = ValueStr;
-    TemBuffer = Value + Width - 1;
-    for (Index = 0; Index < Width; Index ++, TemBuffer --) {
-      UnicodeValueToStringS (
-        TemString,
-        Length  * sizeof (CHAR16) - ((UINTN)TemString - (UINTN)ValueStr),
-        PREFIX_ZERO | RADIX_HEX,
-        *TemBuffer,
-        2
-        );
-      TemString += StrnLenS (TemString, Length - ((UINTN)TemString - (UINTN)ValueStr) / sizeof (CHAR16));
-    }
-
-    FreePool (Value);
-    Value = NULL;
-
     //
-    // Build a ConfigElement
+    // Build a ConfigElement: copy <BlockName> and convert the value to hex
+    // directly from the block.
     //
-    Length += StringPtr - TmpPtr + 1 + StrLen (L"VALUE=");
-    ConfigElement = (EFI_STRING) AllocateZeroPool (Length * sizeof (CHAR16));
-    if (ConfigElement == NULL) {
-      Status = EFI_OUT_OF_RESOURCES;
-      goto Exit;
+    Status = AppendToConfigStringBuilder (&Builder, TmpPtr, StringPtr - TmpPtr);
+    if (!EFI_ERROR (Status)) {
+      Status = AppendToConfigStringBuilder (&Builder, L"&VALUE=", StrLen (L"&VALUE="));
     }
-    CopyMem (ConfigElement, TmpPtr, (StringPtr - TmpPtr + 1) * sizeof (CHAR16));
-    if (*StringPtr == 0) {
-      *(ConfigElement + (StringPtr - TmpPtr)) = L'&';
+    if (!EFI_ERROR (Status)) {
+      Status = AppendHexToConfigStringBuilder (&Builder, Block + Offset, Width);
+    }
+    if (EFI_ERROR (Status)) {
+      *Progress = ConfigRequest;
+      goto Exit;
     }
-    *(ConfigElement + (StringPtr - TmpPtr) + 1) = 0;
-    StrCatS (ConfigElement, Length, L"VALUE=");
-    StrCatS (ConfigElement, Length, ValueStr);
-
-    AppendToMultiString (Config, ConfigElement);
-
-    FreePool (ConfigElement);
-    FreePool (ValueStr);
-    ConfigElement = NULL;
-    ValueStr = NULL;
 
     //
     // If '\0', parsing is finished. Otherwise skip '&' to continue
@@ -5474,7 +5549,11 @@ HiiBlockToConfig (
     if (*StringPtr == 0) {
       break;
     }
-    AppendToMultiString (Config, L"&");
+    Status = AppendToConfigStringBuilder (&Builder, L"&", 1);
+    if (EFI_ERROR (Status)) {
+      *Progress = ConfigRequest;
+      goto Exit;
+    }
     StringPtr++;
 
   }
@@ -5485,24 +5564,13 @@ HiiBlockToConfig (
     goto Exit;
   }
   
-  HiiToLower (*Config);
+  HiiToLower (Builder.String);
+  *Config   = Builder.String;
   *Progress = StringPtr;
   return EFI_SUCCESS;
 
 Exit:
-  if (*Config != NULL) {
-  FreePool (*Config);
-  *Config = NULL;
-  }
-  if (ValueStr != NULL) {
-    FreePool (ValueStr);
-  }
-  if (Value != NULL) {
-    FreePool (Value);
-  }
-  if (ConfigElement != NULL) {
-    FreePool (ConfigElement);
-  }
+  FreePool (Builder.String);
 
   return Status;
 
@@ -5571,15 +5639,12 @@ HiiConfigToBlock (
   EFI_STRING                          TmpPtr;
   UINTN                               Length;
   EFI_STATUS                          Status;
-  UINT8                               *TmpBuffer;
   UINTN                               Offset;
   UINTN                               Width;
   UINT8                               *Value;
   UINTN                               BufferSize;
   UINTN                               MaxBlockSize;
 
-  TmpBuffer = NULL;
-
   if (This == NULL || BlockSize == NULL || Progress == NULL) {
     return EFI_INVALID_PARAMETER;
   }
@@ -5634,18 +5699,11 @@ HiiConfigToBlock (
     //
     // Get Offset
     //
-    Status = GetValueOfNumber (StringPtr, &TmpBuffer, &Length);
+    Status = GetUintnValueOfNumber (StringPtr, &Offset, &Length);
     if (EFI_ERROR (Status)) {
       *Progress = TmpPtr;
       goto Exit;
     }
-    Offset = 0;
-    CopyMem (
-      &Offset,
-      TmpBuffer,
-      (((Length + 1) / 2) < sizeof (UINTN)) ? ((Length + 1) / 2) : sizeof (UINTN)
-      );
-    FreePool (TmpBuffer);
 
     StringPtr += Length;
     if (StrnCmp (StringPtr, L"&WIDTH=", StrLen (L"&WIDTH=")) != 0) {
@@ -5658,18 +5716,11 @@ HiiConfigToBlock (
     //
     // Get Width
     //
-    Status = GetValueOfNumber (StringPtr, &TmpBuffer, &Length);
+    Status = GetUintnValueOfNumber (StringPtr, &Width, &Length);
     if (EFI_ERROR (Status)) {
       *Progress = TmpPtr;
       goto Exit;
     }
-    Width = 0;
-    CopyMem (
-      &Width,
-      TmpBuffer,
-      (((Length + 1) / 2) < sizeof (UINTN)) ? ((Length + 1) / 2) : sizeof (UINTN)
-      );
-    FreePool (TmpBuffer);
 
     StringPtr += Length;
     if (StrnCmp (StringPtr, L"&VALUE=", StrLen (L"&VALUE=")) != 0) {
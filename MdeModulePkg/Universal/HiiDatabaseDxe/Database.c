@@ -966,6 +966,7 @@ AdjustStringPackage (
       *BlockPtr = EFI_HII_SIBT_END;
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringBlockIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += Skip2BlockSize;
       PackageList->PackageListHdr.PackageLength += Skip2BlockSize;
       StringPackage->MaxStringId = MaxStringId;
@@ -1105,6 +1106,7 @@ RemoveStringPackages (
 
     RemoveEntryList (&Package->StringEntry);
     PackageList->PackageListHdr.PackageLength -= Package->StringPkgHdr->Header.Length;
+    InvalidateStringBlockIndex (Package);
     FreePool (Package->StringBlock);
     FreePool (Package->StringPkgHdr);
     //
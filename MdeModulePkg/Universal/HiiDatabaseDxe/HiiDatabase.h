@@ -59,6 +59,16 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define BITMAP_LEN_8_BIT(Width, Height)  ((Width) * (Height))
 #define BITMAP_LEN_24_BIT(Width, Height) ((Width) * (Height) * 3)
 
+//
+// A string built by appending pieces to it. The buffer grows geometrically
+// and the length is tracked, so appending does not rescan the string.
+//
+typedef struct {
+  EFI_STRING          String;
+  UINTN               Length;            // In characters, without the null terminator
+  UINTN               MaxLength;         // In characters, with the null terminator
+} HII_CONFIG_STRING_BUILDER;
+
 //
 // IFR data structure
 //
@@ -145,6 +155,15 @@ typedef struct {
 // String Package definitions
 //
 #define HII_STRING_PACKAGE_SIGNATURE    SIGNATURE_32 ('h','i','s','p')
+
+//
+// Start of a string block which defines at least one string id.
+//
+typedef struct {
+  UINT32                                Offset;        // relative to StringBlock
+  EFI_STRING_ID                         StartStringId; // first id the block defines
+} HII_STRING_BLOCK_INDEX;
+
 typedef struct _HII_STRING_PACKAGE_INSTANCE {
   UINTN                                 Signature;
   EFI_HII_STRING_PACKAGE_HDR            *StringPkgHdr;
@@ -153,6 +172,11 @@ typedef struct _HII_STRING_PACKAGE_INSTANCE {
   LIST_ENTRY                            FontInfoList;  // local font info list
   UINT8                                 FontId;
   EFI_STRING_ID                         MaxStringId;   // record StringId
+  //
+  // Built on first lookup, released whenever StringBlock changes.
+  //
+  HII_STRING_BLOCK_INDEX                *StringIndex;
+  UINTN                                 StringIndexCount;
 } HII_STRING_PACKAGE_INSTANCE;
 
 //
@@ -532,6 +556,18 @@ FindStringBlock (
   OUT EFI_STRING_ID                   *StartStringId OPTIONAL
   );
 
+/**
+  Release the string id index of a string package. It must be called
+  whenever the string blocks of the package are changed.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+InvalidateStringBlockIndex (
+  IN HII_STRING_PACKAGE_INSTANCE      *StringPackage
+  );
+
 
 /**
   Parse all glyph blocks to find a glyph block specified by CharValue.
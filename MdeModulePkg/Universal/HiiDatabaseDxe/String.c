@@ -233,6 +233,187 @@ GetStringFontInfo (
 }
 
 
+/**
+  Release the string id index of a string package. It must be called
+  whenever the string blocks of the package are changed.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+InvalidateStringBlockIndex (
+  IN HII_STRING_PACKAGE_INSTANCE      *StringPackage
+  )
+{
+  if (StringPackage->StringIndex != NULL) {
+    FreePool (StringPackage->StringIndex);
+    StringPackage->StringIndex = NULL;
+  }
+  StringPackage->StringIndexCount = 0;
+}
+
+/**
+  Build the string id index of a string package, recording where every
+  block that defines string ids starts.
+
+  If the string blocks can not be parsed, no index is built and lookups
+  keep walking the blocks from the start.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+BuildStringBlockIndex (
+  IN HII_STRING_PACKAGE_INSTANCE      *StringPackage
+  )
+{
+  HII_STRING_BLOCK_INDEX               *StringIndex;
+  UINTN                                MaxCount;
+  UINTN                                Count;
+  UINT8                                *BlockHdr;
+  UINTN                                BlockSize;
+  UINTN                                BlockLength;
+  UINT8                                *StringTextPtr;
+  EFI_STRING_ID                        CurrentStringId;
+  UINT16                               IdCount;
+  UINTN                                StringSize;
+  UINTN                                Index;
+  UINT8                                Length8;
+  UINT16                               Length16;
+  UINT32                               Length32;
+
+  ASSERT (StringPackage->StringIndex == NULL);
+
+  //
+  // A block defines at least one string id, so there can not be more
+  // entries than string ids.
+  //
+  MaxCount    = (UINTN) StringPackage->MaxStringId + 1;
+  StringIndex = AllocatePool (MaxCount * sizeof (HII_STRING_BLOCK_INDEX));
+  if (StringIndex == NULL) {
+    return;
+  }
+
+  Count           = 0;
+  CurrentStringId = 1;
+  BlockSize       = 0;
+  BlockHdr        = StringPackage->StringBlock;
+  while (*BlockHdr != EFI_HII_SIBT_END) {
+    IdCount     = 0;
+    BlockLength = 0;
+
+    switch (*BlockHdr) {
+    case EFI_HII_SIBT_STRING_SCSU:
+    case EFI_HII_SIBT_STRING_SCSU_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRING_SCSU) {
+        BlockLength = sizeof (EFI_HII_STRING_BLOCK);
+      } else {
+        BlockLength = sizeof (EFI_HII_SIBT_STRING_SCSU_FONT_BLOCK) - sizeof (UINT8);
+      }
+      BlockLength += AsciiStrSize ((CHAR8 *) (BlockHdr + BlockLength));
+      IdCount      = 1;
+      break;
+
+    case EFI_HII_SIBT_STRINGS_SCSU:
+    case EFI_HII_SIBT_STRINGS_SCSU_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRINGS_SCSU) {
+        CopyMem (&IdCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        BlockLength = sizeof (EFI_HII_SIBT_STRINGS_SCSU_BLOCK) - sizeof (UINT8);
+      } else {
+        CopyMem (&IdCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+        BlockLength = sizeof (EFI_HII_SIBT_STRINGS_SCSU_FONT_BLOCK) - sizeof (UINT8);
+      }
+      for (Index = 0; Index < IdCount; Index++) {
+        BlockLength += AsciiStrSize ((CHAR8 *) (BlockHdr + BlockLength));
+      }
+      break;
+
+    case EFI_HII_SIBT_STRING_UCS2:
+    case EFI_HII_SIBT_STRING_UCS2_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRING_UCS2) {
+        BlockLength = sizeof (EFI_HII_STRING_BLOCK);
+      } else {
+        BlockLength = sizeof (EFI_HII_SIBT_STRING_UCS2_FONT_BLOCK) - sizeof (CHAR16);
+      }
+      GetUnicodeStringTextOrSize (NULL, BlockHdr + BlockLength, &StringSize);
+      BlockLength += StringSize;
+      IdCount      = 1;
+      break;
+
+    case EFI_HII_SIBT_STRINGS_UCS2:
+    case EFI_HII_SIBT_STRINGS_UCS2_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRINGS_UCS2) {
+        CopyMem (&IdCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        BlockLength = sizeof (EFI_HII_SIBT_STRINGS_UCS2_BLOCK) - sizeof (CHAR16);
+      } else {
+        CopyMem (&IdCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+        BlockLength = sizeof (EFI_HII_SIBT_STRINGS_UCS2_FONT_BLOCK) - sizeof (CHAR16);
+      }
+      for (Index = 0; Index < IdCount; Index++) {
+        StringTextPtr = BlockHdr + BlockLength;
+        GetUnicodeStringTextOrSize (NULL, StringTextPtr, &StringSize);
+        BlockLength += StringSize;
+      }
+      break;
+
+    case EFI_HII_SIBT_DUPLICATE:
+      BlockLength = sizeof (EFI_HII_SIBT_DUPLICATE_BLOCK);
+      IdCount     = 1;
+      break;
+
+    case EFI_HII_SIBT_SKIP1:
+      BlockLength = sizeof (EFI_HII_SIBT_SKIP1_BLOCK);
+      IdCount     = (UINT16) (*(BlockHdr + sizeof (EFI_HII_STRING_BLOCK)));
+      break;
+
+    case EFI_HII_SIBT_SKIP2:
+      BlockLength = sizeof (EFI_HII_SIBT_SKIP2_BLOCK);
+      CopyMem (&IdCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+      break;
+
+    case EFI_HII_SIBT_EXT1:
+      CopyMem (&Length8, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT8));
+      BlockLength = Length8;
+      break;
+
+    case EFI_HII_SIBT_EXT2:
+      CopyMem (&Length16, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+      BlockLength = Length16;
+      break;
+
+    case EFI_HII_SIBT_EXT4:
+      CopyMem (&Length32, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT32));
+      BlockLength = Length32;
+      break;
+
+    default:
+      break;
+    }
+
+    if (BlockLength == 0) {
+      FreePool (StringIndex);
+      return;
+    }
+
+    if (IdCount != 0) {
+      if (Count == MaxCount) {
+        FreePool (StringIndex);
+        return;
+      }
+      StringIndex[Count].Offset        = (UINT32) BlockSize;
+      StringIndex[Count].StartStringId = CurrentStringId;
+      Count++;
+      CurrentStringId = (EFI_STRING_ID) (CurrentStringId + IdCount);
+    }
+
+    BlockSize += BlockLength;
+    BlockHdr   = StringPackage->StringBlock + BlockSize;
+  }
+
+  StringPackage->StringIndex      = StringIndex;
+  StringPackage->StringIndexCount = Count;
+}
+
 /**
   Parse all string blocks to find a String block specified by StringId.
   If StringId = (EFI_STRING_ID) (-1), find out all EFI_HII_SIBT_FONT blocks
@@ -291,6 +472,8 @@ FindStringBlock (
   UINT32                               Length32;
   UINTN                                StringSize;
   CHAR16                               Zero;
+  UINTN                                Low;
+  UINTN                                High;
 
   ASSERT (StringPackage != NULL);
   ASSERT (StringPackage->Signature == HII_STRING_PACKAGE_SIGNATURE);
@@ -319,6 +502,36 @@ FindStringBlock (
   BlockHdr  = StringPackage->StringBlock;
   BlockSize = 0;
   Offset    = 0;
+
+  if (StringId != (EFI_STRING_ID) (-1) && StringId != 0) {
+    //
+    // Start at the block defining StringId instead of the first block.
+    //
+    if (StringPackage->StringIndex == NULL) {
+      BuildStringBlockIndex (StringPackage);
+    }
+    if (StringPackage->StringIndexCount != 0) {
+      Low  = 0;
+      High = StringPackage->StringIndexCount - 1;
+      while (Low < High) {
+        Index = (Low + High + 1) / 2;
+        if (StringPackage->StringIndex[Index].StartStringId <= StringId) {
+          Low = Index;
+        } else {
+          High = Index - 1;
+        }
+      }
+      if (StringPackage->StringIndex[Low].StartStringId <= StringId) {
+        CurrentStringId = StringPackage->StringIndex[Low].StartStringId;
+        BlockSize       = StringPackage->StringIndex[Low].Offset;
+        BlockHdr        = StringPackage->StringBlock + BlockSize;
+        if (StartStringId != NULL) {
+          *StartStringId = CurrentStringId;
+        }
+      }
+    }
+  }
+
   while (*BlockHdr != EFI_HII_SIBT_END) {
     switch (*BlockHdr) {
     case EFI_HII_SIBT_STRING_SCSU:
@@ -847,6 +1060,7 @@ InsertLackStringBlock (
   }
   FreePool (StringPackage->StringBlock);
   StringPackage->StringBlock = StringBlock;
+  InvalidateStringBlockIndex (StringPackage);
   StringPackage->StringPkgHdr->Header.Length += NewBlockSize - OldBlockSize;
 
   return EFI_SUCCESS;
@@ -1014,6 +1228,7 @@ SetStringWorker (
 
     FreePool (StringPackage->StringBlock);
     StringPackage->StringBlock = Block;
+    InvalidateStringBlockIndex (StringPackage);
     StringPackage->StringPkgHdr->Header.Length += (UINT32) (BlockSize - OldBlockSize);
     break;
 
@@ -1047,6 +1262,7 @@ SetStringWorker (
 
     FreePool (StringPackage->StringBlock);
     StringPackage->StringBlock = Block;
+    InvalidateStringBlockIndex (StringPackage);
     StringPackage->StringPkgHdr->Header.Length += (UINT32) (BlockSize - OldBlockSize);
     break;
 
@@ -1098,6 +1314,7 @@ SetStringWorker (
 
   FreePool (StringPackage->StringBlock);
   StringPackage->StringBlock = Block;
+  InvalidateStringBlockIndex (StringPackage);
   StringPackage->StringPkgHdr->Header.Length += Ext2.Length;
 
   return EFI_SUCCESS;
@@ -1281,6 +1498,7 @@ HiiNewString (
       *BlockPtr = EFI_HII_SIBT_END;
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringBlockIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += Ucs2BlockSize;
       PackageListNode->PackageListHdr.PackageLength += Ucs2BlockSize;
     }
@@ -1412,6 +1630,7 @@ HiiNewString (
     *BlockPtr = EFI_HII_SIBT_END;
     FreePool (StringPackage->StringBlock);
     StringPackage->StringBlock = StringBlock;
+    InvalidateStringBlockIndex (StringPackage);
     StringPackage->StringPkgHdr->Header.Length += Ucs2BlockSize;
     PackageListNode->PackageListHdr.PackageLength += Ucs2BlockSize;
 
@@ -1454,6 +1673,7 @@ HiiNewString (
       *BlockPtr = EFI_HII_SIBT_END;
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringBlockIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += Ucs2FontBlockSize;
       PackageListNode->PackageListHdr.PackageLength += Ucs2FontBlockSize;
 
@@ -1515,6 +1735,7 @@ HiiNewString (
       *BlockPtr = EFI_HII_SIBT_END;
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringBlockIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += FontBlockSize + Ucs2FontBlockSize;
       PackageListNode->PackageListHdr.PackageLength += FontBlockSize + Ucs2FontBlockSize;
 
@@ -1556,6 +1777,7 @@ Done:
     // Free the allocated new string Package when new string can't be added.
     //
     RemoveEntryList (&StringPackage->StringEntry);
+    InvalidateStringBlockIndex (StringPackage);
     FreePool (StringPackage->StringBlock);
     FreePool (StringPackage->StringPkgHdr);
     FreePool (StringPackage);
@@ -31,6 +31,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define MNP_MAX_TX_BUFFER_NUM         65536
 
 #define MNP_MAX_RCVD_PACKET_QUE_SIZE  256
+#define MNP_MAX_RX_PACKETS_PER_POLL   32
 
 #define MNP_RECEIVE_UNICAST           0x01
 #define MNP_RECEIVE_BROADCAST         0x02
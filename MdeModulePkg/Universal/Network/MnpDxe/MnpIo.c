@@ -1124,17 +1124,27 @@ MnpSystemPoll (
   )
 {
   MNP_DEVICE_DATA  *MnpDeviceData;
+  EFI_STATUS       Status;
+  UINTN            Index;
 
   MnpDeviceData = (MNP_DEVICE_DATA *) Context;
   NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
 
   //
-  // Try to receive packets from Snp.
+  // Try to receive packets from Snp. Drain up to MNP_MAX_RX_PACKETS_PER_POLL
+  // packets per tick, so that a burst arriving within one poll interval isn't
+  // throttled to a single packet per interval.
   //
-  MnpReceivePacket (MnpDeviceData);
+  for (Index = 0; Index < MNP_MAX_RX_PACKETS_PER_POLL; Index++) {
+    Status = MnpReceivePacket (MnpDeviceData);
 
-  //
-  // Dispatch the DPC queued by the NotifyFunction of rx token's events.
-  //
-  DispatchDpc ();
+    //
+    // Dispatch the DPC queued by the NotifyFunction of rx token's events.
+    //
+    DispatchDpc ();
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
 }
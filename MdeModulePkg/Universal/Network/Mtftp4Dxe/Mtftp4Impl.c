@@ -81,6 +81,9 @@ Mtftp4CleanOperation (
 
   Instance->BlkSize       = MTFTP4_DEFAULT_BLKSIZE;
   Instance->LastBlock     = 0;
+  Instance->WindowSize    = MTFTP4_DEFAULT_WINDOWSIZE;
+  Instance->WindowReceived = 0;
+  Instance->WindowRecovery = FALSE;
   Instance->ServerIp      = 0;
   Instance->ListeningPort = 0;
   Instance->ConnectedPort = 0;
@@ -432,6 +435,15 @@ Mtftp4Start (
     if (EFI_ERROR (Status)) {
       goto ON_ERROR;
     }
+
+    //
+    // Only the download side implements the windowsize option.
+    //
+    if ((Operation == EFI_MTFTP4_OPCODE_WRQ) &&
+        ((Instance->RequestOption.Exist & MTFTP4_WINDOWSIZE_EXIST) != 0)) {
+      Status = EFI_UNSUPPORTED;
+      goto ON_ERROR;
+    }
   }
 
   //
@@ -440,6 +452,7 @@ Mtftp4Start (
   Config                  = &Instance->Config;
   Instance->Token         = Token;
   Instance->BlkSize       = MTFTP4_DEFAULT_BLKSIZE;
+  Instance->WindowSize    = MTFTP4_DEFAULT_WINDOWSIZE;
 
   CopyMem (&Instance->ServerIp, &Config->ServerIp, sizeof (IP4_ADDR));
   Instance->ServerIp      = NTOHL (Instance->ServerIp);
@@ -56,6 +56,7 @@ typedef struct _MTFTP4_PROTOCOL MTFTP4_PROTOCOL;
 #define MTFTP4_DEFAULT_TIMEOUT      3
 #define MTFTP4_DEFAULT_RETRY        5
 #define MTFTP4_DEFAULT_BLKSIZE      512
+#define MTFTP4_DEFAULT_WINDOWSIZE   1
 #define MTFTP4_TIME_TO_GETMAP       5
 
 #define MTFTP4_STATE_UNCONFIGED     0
@@ -120,6 +121,16 @@ struct _MTFTP4_PROTOCOL {
   UINT16                        LastBlock;
   LIST_ENTRY                    Blocks;
 
+  //
+  // Window of DATA blocks the server sends before it waits for an ACK
+  // (RFC 7440). WindowReceived counts the in-order blocks received since
+  // the last ACK. WindowRecovery is set once an ACK has been sent for a
+  // gap, so the rest of the broken window doesn't trigger more ACKs.
+  //
+  UINT16                        WindowSize;
+  UINT16                        WindowReceived;
+  BOOLEAN                       WindowRecovery;
+
   //
   // The server's communication end point: IP and two ports. one for
   // initial request, one for its selected port.
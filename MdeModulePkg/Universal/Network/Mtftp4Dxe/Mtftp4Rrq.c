@@ -115,6 +115,8 @@ Mtftp4RrqSendAck (
   Ack->Ack.OpCode   = HTONS (EFI_MTFTP4_OPCODE_ACK);
   Ack->Ack.Block[0] = HTONS (BlkNo);
 
+  Instance->WindowReceived = 0;
+
   return Mtftp4SendPacket (Instance, Packet);
 }
 
@@ -267,8 +269,18 @@ Mtftp4RrqHandleData (
   // the last ACK then restart receiving. If we are passive, save
   // the block.
   //
+  // With a window larger than one, ACK the last in-order block so the
+  // server restarts the window from the gap. The remaining blocks of the
+  // broken window are dropped without further ACKs.
+  //
   if (Instance->Master && (Expected != BlockNum)) {
-    Mtftp4Retransmit (Instance);
+    if (Instance->WindowSize <= 1) {
+      Mtftp4Retransmit (Instance);
+    } else if (!Instance->WindowRecovery) {
+      Instance->WindowRecovery = TRUE;
+      return Mtftp4RrqSendAck (Instance, (UINT16) (Expected - 1));
+    }
+
     return EFI_SUCCESS;
   }
 
@@ -278,11 +290,15 @@ Mtftp4RrqHandleData (
     return Status;
   }
 
+  Instance->WindowRecovery = FALSE;
+  Instance->WindowReceived++;
+
   //
   // Reset the passive client's timer whenever it received a
-  // valid data packet.
+  // valid data packet. The active client resets it too when it
+  // doesn't ACK every block.
   //
-  if (!Instance->Master) {
+  if (!Instance->Master || (Instance->WindowSize > 1)) {
     Mtftp4SetTimeout (Instance);
   }
 
@@ -306,6 +322,13 @@ Mtftp4RrqHandleData (
       *Completed = TRUE;
 
     } else {
+      //
+      // Only ACK the last block of each window.
+      //
+      if (Instance->WindowReceived < Instance->WindowSize) {
+        return EFI_SUCCESS;
+      }
+
       BlockNum = (UINT16) (Expected - 1);
     }
 
@@ -324,6 +347,7 @@ Mtftp4RrqHandleData (
   2. The server can only use smaller blksize than that is requested
   3. The server can only use the same timeout as requested
   4. The server doesn't change its multicast channel.
+  5. The server can only use smaller windowsize than that is requested
 
   @param  This                  The downloading Mtftp session
   @param  Reply                 The options in the OACK packet
@@ -357,6 +381,10 @@ Mtftp4RrqOackValid (
     return FALSE;
   }
 
+  if (((Reply->Exist & MTFTP4_WINDOWSIZE_EXIST) != 0) && (Reply->WindowSize > Request->WindowSize)) {
+    return FALSE;
+  }
+
   //
   // The server can send ",,master" to client to change its master
   // setting. But if it use the specific multicast channel, it can't
@@ -614,6 +642,13 @@ Mtftp4RrqHandleOack (
     if (Reply.Timeout != 0) {
       Instance->Timeout = Reply.Timeout;
     }
+
+    //
+    // The window only applies to unicast download.
+    //
+    if (Reply.WindowSize != 0) {
+      Instance->WindowSize = Reply.WindowSize;
+    }
   }
   
   //
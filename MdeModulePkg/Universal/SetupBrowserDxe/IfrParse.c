@@ -566,6 +566,7 @@ CreateStorage (
   Storage->BrowserStorage = BrowserStorage;
   InitializeConfigHdr (FormSet, Storage);
   Storage->ConfigRequest = AllocateCopyPool (StrSize (Storage->ConfigHdr), Storage->ConfigHdr);
+  Storage->ConfigRequestLen = StrLen (Storage->ConfigHdr);
   Storage->SpareStrLen = 0;
 
   return Storage;
@@ -661,6 +662,54 @@ GetFstStgFromBrsStg (
   return Found ? FormsetStorage : NULL;
 }
 
+/**
+  Append a <RequestElement> to a <ConfigRequest>.
+
+  The length of the <ConfigRequest> is tracked and its buffer is at least
+  doubled when it is full, so building the <ConfigRequest> of a storage
+  takes linear time in the number of Questions using it.
+
+  @param  ConfigRequest          Pointer to the <ConfigRequest>, reallocated
+                                 when it is too small.
+  @param  ConfigRequestLen       Length of the <ConfigRequest> in characters.
+  @param  SpareStrLen            Spare length of the <ConfigRequest> buffer.
+  @param  RequestElement         The <RequestElement> to append.
+  @param  ElementLen             Length of RequestElement in characters.
+
+**/
+VOID
+AppendRequestElement (
+  IN OUT CHAR16                   **ConfigRequest,
+  IN OUT UINTN                    *ConfigRequestLen,
+  IN OUT UINTN                    *SpareStrLen,
+  IN     CHAR16                   *RequestElement,
+  IN     UINTN                    ElementLen
+  )
+{
+  UINTN            MaxLen;
+  CHAR16           *NewStr;
+
+  if (ElementLen > *SpareStrLen) {
+    //
+    // Old String buffer is not sufficient for RequestElement, allocate a new one
+    //
+    MaxLen = *ConfigRequestLen + 1 + *SpareStrLen;
+    MaxLen = MAX (MaxLen * 2, *ConfigRequestLen + 1 + ElementLen + CONFIG_REQUEST_STRING_INCREMENTAL);
+    NewStr = AllocateZeroPool (MaxLen * sizeof (CHAR16));
+    ASSERT (NewStr != NULL);
+    if (*ConfigRequest != NULL) {
+      CopyMem (NewStr, *ConfigRequest, (*ConfigRequestLen + 1) * sizeof (CHAR16));
+      FreePool (*ConfigRequest);
+    }
+    *ConfigRequest = NewStr;
+    *SpareStrLen   = MaxLen - *ConfigRequestLen - 1;
+  }
+
+  CopyMem (*ConfigRequest + *ConfigRequestLen, RequestElement, (ElementLen + 1) * sizeof (CHAR16));
+  *ConfigRequestLen += ElementLen;
+  *SpareStrLen      -= ElementLen;
+}
+
 /**
   Initialize Request Element of a Question. <RequestElement> ::= '&'<BlockName> | '&'<Label>
 
@@ -682,13 +731,10 @@ InitializeRequestElement (
   BROWSER_STORAGE  *Storage;
   FORMSET_STORAGE  *FormsetStorage;
   UINTN            StrLen;
-  UINTN            StringSize;
-  CHAR16           *NewStr;
   CHAR16           RequestElement[30];
   LIST_ENTRY       *Link;
   BOOLEAN          Find;
   FORM_BROWSER_CONFIG_REQUEST  *ConfigInfo;
-  UINTN            MaxLen;
 
   Storage = Question->Storage;
   if (Storage == NULL) {
@@ -734,30 +780,18 @@ InitializeRequestElement (
   //
   FormsetStorage = GetFstStgFromVarId(FormSet, Question->VarStoreId);
   ASSERT (FormsetStorage != NULL);
-  StringSize = (FormsetStorage->ConfigRequest != NULL) ? StrSize (FormsetStorage->ConfigRequest) : sizeof (CHAR16);
-  MaxLen = StringSize / sizeof (CHAR16) + FormsetStorage->SpareStrLen;
 
   //
   // Append <RequestElement> to <ConfigRequest>
   //
-  if (StrLen > FormsetStorage->SpareStrLen) {
-    //
-    // Old String buffer is not sufficient for RequestElement, allocate a new one
-    //
-    MaxLen = StringSize / sizeof (CHAR16) + CONFIG_REQUEST_STRING_INCREMENTAL;
-    NewStr = AllocateZeroPool (MaxLen * sizeof (CHAR16));
-    ASSERT (NewStr != NULL);
-    if (FormsetStorage->ConfigRequest != NULL) {
-      CopyMem (NewStr, FormsetStorage->ConfigRequest, StringSize);
-      FreePool (FormsetStorage->ConfigRequest);
-    }
-    FormsetStorage->ConfigRequest = NewStr;
-    FormsetStorage->SpareStrLen   = CONFIG_REQUEST_STRING_INCREMENTAL;
-  }
-
-  StrCatS (FormsetStorage->ConfigRequest, MaxLen, RequestElement);
+  AppendRequestElement (
+    &FormsetStorage->ConfigRequest,
+    &FormsetStorage->ConfigRequestLen,
+    &FormsetStorage->SpareStrLen,
+    RequestElement,
+    StrLen
+    );
   FormsetStorage->ElementCount++;
-  FormsetStorage->SpareStrLen -= StrLen;
 
   //
   // Update the Config Request info saved in the form.
@@ -782,34 +816,23 @@ InitializeRequestElement (
     ConfigInfo->Signature     = FORM_BROWSER_CONFIG_REQUEST_SIGNATURE;
     ConfigInfo->ConfigRequest = AllocateCopyPool (StrSize (FormsetStorage->ConfigHdr), FormsetStorage->ConfigHdr);
     ASSERT (ConfigInfo->ConfigRequest != NULL);
+    ConfigInfo->ConfigRequestLen = StrSize (FormsetStorage->ConfigHdr) / sizeof (CHAR16) - 1;
     ConfigInfo->SpareStrLen   = 0;
     ConfigInfo->Storage       = FormsetStorage->BrowserStorage;
     InsertTailList(&Form->ConfigRequestHead, &ConfigInfo->Link);
   }
-  StringSize = (ConfigInfo->ConfigRequest != NULL) ? StrSize (ConfigInfo->ConfigRequest) : sizeof (CHAR16);
-  MaxLen = StringSize / sizeof (CHAR16) + ConfigInfo->SpareStrLen;
 
   //
   // Append <RequestElement> to <ConfigRequest>
   //
-  if (StrLen > ConfigInfo->SpareStrLen) {
-    //
-    // Old String buffer is not sufficient for RequestElement, allocate a new one
-    //
-    MaxLen = StringSize / sizeof (CHAR16) + CONFIG_REQUEST_STRING_INCREMENTAL;
-    NewStr = AllocateZeroPool (MaxLen * sizeof (CHAR16));
-    ASSERT (NewStr != NULL);
-    if (ConfigInfo->ConfigRequest != NULL) {
-      CopyMem (NewStr, ConfigInfo->ConfigRequest, StringSize);
-      FreePool (ConfigInfo->ConfigRequest);
-    }
-    ConfigInfo->ConfigRequest = NewStr;
-    ConfigInfo->SpareStrLen   = CONFIG_REQUEST_STRING_INCREMENTAL;
-  }
-
-  StrCatS (ConfigInfo->ConfigRequest, MaxLen, RequestElement);
+  AppendRequestElement (
+    &ConfigInfo->ConfigRequest,
+    &ConfigInfo->ConfigRequestLen,
+    &ConfigInfo->SpareStrLen,
+    RequestElement,
+    StrLen
+    );
   ConfigInfo->ElementCount++;
-  ConfigInfo->SpareStrLen -= StrLen;
   return EFI_SUCCESS;
 }
 
@@ -177,6 +177,7 @@ typedef struct {
   CHAR16           *ConfigAltResp; // Alt config response string for this ConfigRequest.
   BOOLEAN          HasCallAltCfg;  // Flag to show whether browser has call ExtractConfig to get Altcfg string.
   UINTN            ElementCount;   // Number of <RequestElement> in the <ConfigRequest>
+  UINTN            ConfigRequestLen; // Length of ConfigRequest string, not including the NULL terminator
   UINTN            SpareStrLen;    // Spare length of ConfigRequest string buffer
   CHAR16           *RestoreConfigRequest; // When submit formset fail, the element need to be restored
   CHAR16           *SyncConfigRequest;    // When submit formset fail, the element need to be synced
@@ -388,6 +389,7 @@ typedef struct {
   CHAR16                *ConfigRequest; // <ConfigRequest> = <ConfigHdr> + <RequestElement>
   CHAR16                *ConfigAltResp; // Alt config response string for this ConfigRequest.
   UINTN                 ElementCount;   // Number of <RequestElement> in the <ConfigRequest>  
+  UINTN                 ConfigRequestLen; // Length of ConfigRequest string, not including the NULL terminator
   UINTN                 SpareStrLen;
   CHAR16                *RestoreConfigRequest; // When submit form fail, the element need to be restored
   CHAR16                *SyncConfigRequest;    // When submit form fail, the element need to be synced
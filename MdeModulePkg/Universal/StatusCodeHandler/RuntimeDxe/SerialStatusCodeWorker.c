@@ -14,6 +14,228 @@
 
 #include "StatusCodeHandlerRuntimeDxe.h"
 
+//
+// Ring buffer of messages not sent to the serial device yet. Messages are
+// appended with the TPL raised to TPL_HIGH_LEVEL, so a status code reported
+// from a notification function cannot interleave with the one it interrupted.
+// Only the owner of mSerialStatusCodeDraining sends bytes and advances
+// DrainedBytes; a caller interrupting the owner never waits for it. Such a
+// caller that has to write synchronously, for an error code or because the
+// buffer is full, writes its message directly. That message then appears
+// ahead of the buffered bytes the interrupted owner has not sent yet.
+//
+EDKII_SERIAL_STATUS_CODE_BUFFER  *mSerialStatusCodeBuffer    = NULL;
+volatile UINT32                  mSerialStatusCodeDraining   = 0;
+EFI_EVENT                        mSerialStatusCodeDrainEvent = NULL;
+UINTN                            mSerialStatusCodeDrainSize  = 0;
+
+/**
+  Send the oldest bytes of the serial status code buffer to the serial device.
+
+  @param  MaxBytes  Maximum number of bytes to send.
+
+  @retval TRUE      The bytes were sent, or the buffer is empty.
+  @retval FALSE     The buffer is being drained by an interrupted caller.
+
+**/
+BOOLEAN
+DrainSerialStatusCodeBuffer (
+  IN UINTN                    MaxBytes
+  )
+{
+  EDKII_SERIAL_STATUS_CODE_BUFFER  *Ring;
+  UINT32                           Offset;
+  UINTN                            Count;
+
+  Ring = mSerialStatusCodeBuffer;
+  if (Ring == NULL) {
+    return TRUE;
+  }
+
+  if (InterlockedCompareExchange32 (&mSerialStatusCodeDraining, 0, 1) != 0) {
+    return FALSE;
+  }
+
+  while ((MaxBytes != 0) && (Ring->DrainedBytes != Ring->WrittenBytes)) {
+    Offset = Ring->DrainedBytes & (Ring->BufferSize - 1);
+    Count  = MIN (MaxBytes, (UINTN) (Ring->WrittenBytes - Ring->DrainedBytes));
+    Count  = MIN (Count, (UINTN) (Ring->BufferSize - Offset));
+
+    SerialPortWrite ((UINT8 *) (Ring + 1) + Offset, Count);
+
+    Ring->DrainedBytes += (UINT32) Count;
+    MaxBytes           -= Count;
+  }
+
+  mSerialStatusCodeDraining = 0;
+  return TRUE;
+}
+
+/**
+  Append a message to the serial status code buffer.
+
+  If the buffer has no room left, the oldest bytes are sent to the serial
+  device first. If that is not possible because the buffer is being drained by
+  an interrupted caller, the message is written to the serial device directly,
+  ahead of the bytes that caller has not sent yet.
+
+  @param  Message  The message.
+  @param  Length   Number of bytes of the message.
+
+**/
+VOID
+WriteSerialStatusCodeBuffer (
+  IN UINT8                    *Message,
+  IN UINTN                    Length
+  )
+{
+  EDKII_SERIAL_STATUS_CODE_BUFFER  *Ring;
+  EFI_TPL                          OldTpl;
+  UINT32                           Offset;
+  UINTN                            Count;
+
+  Ring = mSerialStatusCodeBuffer;
+  if ((UINTN) (Ring->WrittenBytes - Ring->DrainedBytes) + Length > Ring->BufferSize) {
+    DrainSerialStatusCodeBuffer ((UINTN) (Ring->WrittenBytes - Ring->DrainedBytes) + Length - Ring->BufferSize);
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  if ((UINTN) (Ring->WrittenBytes - Ring->DrainedBytes) + Length > Ring->BufferSize) {
+    gBS->RestoreTPL (OldTpl);
+    SerialPortWrite (Message, Length);
+    return;
+  }
+
+  Offset = Ring->WrittenBytes & (Ring->BufferSize - 1);
+  Count  = MIN (Length, (UINTN) (Ring->BufferSize - Offset));
+  CopyMem ((UINT8 *) (Ring + 1) + Offset, Message, Count);
+  CopyMem (Ring + 1, Message + Count, Length - Count);
+  Ring->WrittenBytes += (UINT32) Length;
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  Timer event notification function sending buffered messages to the serial
+  device, at most as many bytes as the serial device transmits in one period.
+
+  @param  Event         Event whose notification function is being invoked.
+  @param  Context       Pointer to the notification function's context, which is
+                        always zero in current implementation.
+
+**/
+VOID
+EFIAPI
+SerialStatusCodeBufferTimerHandler (
+  IN EFI_EVENT        Event,
+  IN VOID             *Context
+  )
+{
+  DrainSerialStatusCodeBuffer (mSerialStatusCodeDrainSize);
+}
+
+/**
+  Allocate the serial status code buffer, install it as a configuration table
+  and start the timer event sending its content to the serial device.
+
+  @retval EFI_SUCCESS           The serial status code buffer is ready.
+  @retval EFI_OUT_OF_RESOURCES  The buffer could not be allocated.
+  @retval others                Errors from creating the timer event or from
+                                gBS->InstallConfigurationTable(). Messages are
+                                written to the serial device directly.
+
+**/
+EFI_STATUS
+SerialStatusCodeBufferInitializeWorker (
+  VOID
+  )
+{
+  EFI_STATUS                       Status;
+  EDKII_SERIAL_STATUS_CODE_BUFFER  *Ring;
+  UINT32                           BufferSize;
+
+  BufferSize = GetPowerOfTwo32 ((UINT32) PcdGet16 (PcdStatusCodeSerialBufferSize) * 1024);
+
+  //
+  // Allocate from runtime memory, like the memory status code table, so the
+  // last messages of the boot stay readable.
+  //
+  Ring = AllocateRuntimePool (sizeof (EDKII_SERIAL_STATUS_CODE_BUFFER) + BufferSize);
+  if (Ring == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Ring->BufferSize   = BufferSize;
+  Ring->WrittenBytes = 0;
+  Ring->DrainedBytes = 0;
+  Ring->Reserved     = 0;
+
+  //
+  // Ten bits are sent for every byte.
+  //
+  mSerialStatusCodeDrainSize = (UINTN) DivU64x32 (
+                                         MultU64x32 (PcdGet32 (PcdSerialBaudRate), SERIAL_STATUS_CODE_DRAIN_PERIOD),
+                                         10 * 10000000
+                                         );
+  mSerialStatusCodeDrainSize = MAX (mSerialStatusCodeDrainSize, 1);
+
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  SerialStatusCodeBufferTimerHandler,
+                  NULL,
+                  &mSerialStatusCodeDrainEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
+
+  Status = gBS->InstallConfigurationTable (&gEdkiiSerialStatusCodeBufferGuid, Ring);
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
+
+  //
+  // The timer handler drains mSerialStatusCodeBuffer, so it must be set
+  // before the timer is armed.
+  //
+  mSerialStatusCodeBuffer = Ring;
+
+  Status = gBS->SetTimer (mSerialStatusCodeDrainEvent, TimerPeriodic, SERIAL_STATUS_CODE_DRAIN_PERIOD);
+  if (EFI_ERROR (Status)) {
+    mSerialStatusCodeBuffer = NULL;
+    gBS->InstallConfigurationTable (&gEdkiiSerialStatusCodeBufferGuid, NULL);
+    goto Done;
+  }
+
+Done:
+  if (EFI_ERROR (Status)) {
+    if (mSerialStatusCodeDrainEvent != NULL) {
+      gBS->CloseEvent (mSerialStatusCodeDrainEvent);
+      mSerialStatusCodeDrainEvent = NULL;
+    }
+    FreePool (Ring);
+  }
+
+  return Status;
+}
+
+/**
+  Stop the timer event and send all buffered messages to the serial device.
+
+**/
+VOID
+SerialStatusCodeBufferFlush (
+  VOID
+  )
+{
+  if (mSerialStatusCodeBuffer == NULL) {
+    return;
+  }
+
+  gBS->SetTimer (mSerialStatusCodeDrainEvent, TimerCancel, 0);
+  DrainSerialStatusCodeBuffer (MAX_UINTN);
+}
+
 /**
   Convert status code value and extended data to readable ASCII string, send string to serial I/O device.
  
@@ -152,10 +374,23 @@ SerialStatusCodeReportWorker (
                   );
   }
 
-  //
-  // Call SerialPort Lib function to do print.
-  //
-  SerialPortWrite ((UINT8 *) Buffer, CharCount);
+  if (mSerialStatusCodeBuffer == NULL) {
+    //
+    // Call SerialPort Lib function to do print.
+    //
+    SerialPortWrite ((UINT8 *) Buffer, CharCount);
+  } else if ((CodeType & EFI_STATUS_CODE_TYPE_MASK) == EFI_ERROR_CODE) {
+    //
+    // Error codes, ASSERT() included, may be followed by CpuDeadLoop() or a
+    // reset. Send the buffered messages and this one before returning. If
+    // this interrupted the drain, the bytes it has not sent yet follow this
+    // message.
+    //
+    DrainSerialStatusCodeBuffer (MAX_UINTN);
+    SerialPortWrite ((UINT8 *) Buffer, CharCount);
+  } else {
+    WriteSerialStatusCodeBuffer ((UINT8 *) Buffer, CharCount);
+  }
 
   return EFI_SUCCESS;
 }
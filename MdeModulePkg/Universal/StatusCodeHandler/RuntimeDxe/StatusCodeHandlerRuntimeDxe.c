@@ -36,6 +36,7 @@ UnregisterBootTimeHandlers (
   )
 {
   if (FeaturePcdGet (PcdStatusCodeUseSerial)) {
+    SerialStatusCodeBufferFlush ();
     mRscHandlerProtocol->Unregister (SerialStatusCodeReportWorker);
   }
 }
@@ -92,6 +93,11 @@ InitializationDispatcherWorker (
     //
     Status = SerialPortInitialize ();
     ASSERT_EFI_ERROR (Status);
+
+    if (PcdGet16 (PcdStatusCodeSerialBufferSize) != 0) {
+      Status = SerialStatusCodeBufferInitializeWorker ();
+      ASSERT_EFI_ERROR (Status);
+    }
   }
   if (FeaturePcdGet (PcdStatusCodeUseMemory)) {
     Status = RtMemoryStatusCodeInitializeWorker ();
@@ -22,7 +22,9 @@
 #include <Guid/StatusCodeDataTypeId.h>
 #include <Guid/StatusCodeDataTypeDebug.h>
 #include <Guid/EventGroup.h>
+#include <Guid/SerialStatusCodeBuffer.h>
 
+#include <Library/BaseLib.h>
 #include <Library/SynchronizationLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
@@ -41,6 +43,11 @@
 //
 #define MAX_DEBUG_MESSAGE_LENGTH 0x100
 
+//
+// Period of the timer event draining the serial status code buffer, in 100ns units.
+//
+#define SERIAL_STATUS_CODE_DRAIN_PERIOD  100000
+
 extern RUNTIME_MEMORY_STATUSCODE_HEADER  *mRtMemoryStatusCodeTable;
 
 /**
@@ -84,6 +91,31 @@ SerialStatusCodeReportWorker (
   IN EFI_STATUS_CODE_DATA     *Data OPTIONAL
   );
 
+/**
+  Allocate the serial status code buffer, install it as a configuration table
+  and start the timer event sending its content to the serial device.
+
+  @retval EFI_SUCCESS           The serial status code buffer is ready.
+  @retval EFI_OUT_OF_RESOURCES  The buffer could not be allocated.
+  @retval others                Errors from creating the timer event or from
+                                gBS->InstallConfigurationTable(). Messages are
+                                written to the serial device directly.
+
+**/
+EFI_STATUS
+SerialStatusCodeBufferInitializeWorker (
+  VOID
+  );
+
+/**
+  Stop the timer event and send all buffered messages to the serial device.
+
+**/
+VOID
+SerialStatusCodeBufferFlush (
+  VOID
+  );
+
 /**
   Initialize runtime memory status code table as initialization for runtime memory status code worker
  
@@ -249,6 +249,14 @@
 ///
 #define  HTTP_EXPECT_100_CONTINUE       "100-continue"
 
+///
+/// Range Request Header
+/// The Range request-header field requests one or more sub-ranges of the
+/// entity, instead of the entire entity.
+/// Example:     Range: bytes=0-499
+///
+#define  HTTP_HEADER_RANGE             "Range"
+
 #pragma pack()
 
 #endif
@@ -663,8 +663,8 @@ typedef struct {
   //
   UINT8  Opc;               // Opcode
   UINT8  Fuse:2;            // Fused Operation
-  UINT8  Rsvd1:5;
-  UINT8  Psdt:1;            // PRP or SGL for Data Transfer
+  UINT8  Rsvd1:4;
+  UINT8  Psdt:2;            // PRP or SGL for Data Transfer
   UINT16 Cid;               // Command Identifier
 
   //
@@ -452,21 +452,22 @@ HttpBootDiscoverBootInfo (
 }
 
 /**
-  Create a HttpIo instance for the file download.
+  Create and configure a HttpIo instance on the boot NIC.
 
   @param[in]    Private        The pointer to the driver's private data.
+  @param[out]   HttpIo         The HttpIo instance to initialize.
 
   @retval EFI_SUCCESS          Successfully created.
   @retval Others               Failed to create HttpIo.
 
 **/
 EFI_STATUS
-HttpBootCreateHttpIo (
-  IN     HTTP_BOOT_PRIVATE_DATA       *Private
+HttpBootInitHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA       *Private,
+     OUT HTTP_IO                      *HttpIo
   )
 {
   HTTP_IO_CONFIG_DATA          ConfigData;
-  EFI_STATUS                   Status;
   EFI_HANDLE                   ImageHandle;
 
   ASSERT (Private != NULL);
@@ -485,13 +486,34 @@ HttpBootCreateHttpIo (
     ImageHandle = Private->Ip6Nic->ImageHandle;
   }
 
-  Status = HttpIoCreateIo (
-             ImageHandle,
-             Private->Controller,
-             Private->UsingIpv6 ? IP_VERSION_6 : IP_VERSION_4,
-             &ConfigData,
-             &Private->HttpIo
-             );
+  return HttpIoCreateIo (
+           ImageHandle,
+           Private->Controller,
+           Private->UsingIpv6 ? IP_VERSION_6 : IP_VERSION_4,
+           &ConfigData,
+           HttpIo
+           );
+}
+
+/**
+  Create a HttpIo instance for the file download.
+
+  @param[in]    Private        The pointer to the driver's private data.
+
+  @retval EFI_SUCCESS          Successfully created.
+  @retval Others               Failed to create HttpIo.
+
+**/
+EFI_STATUS
+HttpBootCreateHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA       *Private
+  )
+{
+  EFI_STATUS                   Status;
+
+  ASSERT (Private != NULL);
+
+  Status = HttpBootInitHttpIo (Private, &Private->HttpIo);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -726,6 +748,371 @@ HttpBootGetBootFileCallback (
   return EFI_SUCCESS;
 }
 
+/**
+  Send the HTTP GET request for the bytes of the range which are not received yet.
+
+  The request is only queued to the HTTP instance, HttpBootRangeProcess() checks
+  its completion.
+
+  @param[in]       HostName        The host name of the boot file URI.
+  @param[in, out]  Connection      The range connection.
+
+  @retval EFI_SUCCESS              The request is queued.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval Others                   Unexpected error happened.
+
+**/
+EFI_STATUS
+HttpBootRangeSendRequest (
+  IN     CHAR8                        *HostName,
+  IN OUT HTTP_BOOT_RANGE_CONNECTION   *Connection
+  )
+{
+  EFI_STATUS                 Status;
+  HTTP_IO                    *HttpIo;
+  CHAR8                      Range[sizeof ("bytes=18446744073709551615-18446744073709551615")];
+
+  if (Connection->Header != NULL) {
+    HttpBootFreeHeader (Connection->Header);
+  }
+
+  //
+  // 4 headers are needed to request a range of the boot file:
+  //       Host
+  //       Accept
+  //       User-Agent
+  //       Range
+  //
+  Connection->Header = HttpBootCreateHeader (4);
+  if (Connection->Header == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  AsciiSPrint (
+    Range,
+    sizeof (Range),
+    "bytes=%Lu-%Lu",
+    (UINT64) (Connection->Start + Connection->Received),
+    (UINT64) Connection->End
+    );
+
+  Status = HttpBootSetHeader (Connection->Header, HTTP_HEADER_HOST, HostName);
+  if (!EFI_ERROR (Status)) {
+    Status = HttpBootSetHeader (Connection->Header, HTTP_HEADER_ACCEPT, "*/*");
+  }
+  if (!EFI_ERROR (Status)) {
+    Status = HttpBootSetHeader (Connection->Header, HTTP_HEADER_USER_AGENT, HTTP_USER_AGENT_EFI_HTTP_BOOT);
+  }
+  if (!EFI_ERROR (Status)) {
+    Status = HttpBootSetHeader (Connection->Header, HTTP_HEADER_RANGE, Range);
+  }
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  HttpIo = &Connection->HttpIo;
+  HttpIo->ReqToken.Status                = EFI_NOT_READY;
+  HttpIo->ReqToken.Message->Data.Request = &Connection->RequestData;
+  HttpIo->ReqToken.Message->HeaderCount  = Connection->Header->HeaderCount;
+  HttpIo->ReqToken.Message->Headers      = Connection->Header->Headers;
+  HttpIo->ReqToken.Message->BodyLength   = 0;
+  HttpIo->ReqToken.Message->Body         = NULL;
+
+  HttpIo->IsTxDone = FALSE;
+  Status = HttpIo->Http->Request (HttpIo->Http, &HttpIo->ReqToken);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Connection->State = HttpBootRangeStateRequest;
+  return EFI_SUCCESS;
+}
+
+/**
+  Queue a response token to receive the response header or the next part of
+  the message-body of a range connection.
+
+  The message-body is received into the caller's buffer directly.
+
+  @param[in, out]  Connection      The range connection.
+  @param[in]       RecvMsgHeader   TRUE to receive the response header.
+  @param[out]      Buffer          The buffer to download the whole boot file to.
+
+  @retval EFI_SUCCESS              The response token is queued.
+  @retval Others                   Unexpected error happened.
+
+**/
+EFI_STATUS
+HttpBootRangeRecvResponse (
+  IN OUT HTTP_BOOT_RANGE_CONNECTION   *Connection,
+  IN     BOOLEAN                      RecvMsgHeader,
+     OUT UINT8                        *Buffer
+  )
+{
+  EFI_STATUS                 Status;
+  HTTP_IO                    *HttpIo;
+
+  HttpIo = &Connection->HttpIo;
+
+  Status = gBS->SetTimer (HttpIo->TimeoutEvent, TimerRelative, HTTP_BOOT_RESPONSE_TIMEOUT * TICKS_PER_MS);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  HttpIo->RspToken.Status               = EFI_NOT_READY;
+  HttpIo->RspToken.Message->HeaderCount = 0;
+  HttpIo->RspToken.Message->Headers     = NULL;
+  if (RecvMsgHeader) {
+    HttpIo->RspToken.Message->Data.Response = &Connection->ResponseData;
+    HttpIo->RspToken.Message->BodyLength    = 0;
+    HttpIo->RspToken.Message->Body          = NULL;
+    Connection->State = HttpBootRangeStateHeader;
+  } else {
+    HttpIo->RspToken.Message->Data.Response = NULL;
+    HttpIo->RspToken.Message->BodyLength    = Connection->End + 1 - Connection->Start - Connection->Received;
+    HttpIo->RspToken.Message->Body          = Buffer + Connection->Start + Connection->Received;
+    Connection->State = HttpBootRangeStateBody;
+  }
+
+  HttpIo->IsRxDone = FALSE;
+  Status = HttpIo->Http->Response (HttpIo->Http, &HttpIo->RspToken);
+  if (EFI_ERROR (Status)) {
+    gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+  }
+
+  return Status;
+}
+
+/**
+  Check the progress of a range connection and queue its next operation.
+
+  @param[in, out]  Connection      The range connection.
+  @param[out]      Buffer          The buffer to download the whole boot file to.
+
+  @retval EFI_SUCCESS              The connection is in progress or done.
+  @retval EFI_TIMEOUT              No response is received in time.
+  @retval EFI_UNSUPPORTED          The server didn't return the requested range.
+  @retval Others                   The connection failed.
+
+**/
+EFI_STATUS
+HttpBootRangeProcess (
+  IN OUT HTTP_BOOT_RANGE_CONNECTION   *Connection,
+     OUT UINT8                        *Buffer
+  )
+{
+  HTTP_IO                    *HttpIo;
+  EFI_HTTP_MESSAGE           *Message;
+
+  HttpIo = &Connection->HttpIo;
+
+  switch (Connection->State) {
+  case HttpBootRangeStateRequest:
+    if (!HttpIo->IsTxDone) {
+      return EFI_SUCCESS;
+    }
+
+    if (EFI_ERROR (HttpIo->ReqToken.Status)) {
+      return HttpIo->ReqToken.Status;
+    }
+
+    return HttpBootRangeRecvResponse (Connection, TRUE, Buffer);
+
+  case HttpBootRangeStateHeader:
+  case HttpBootRangeStateBody:
+    if (!HttpIo->IsRxDone) {
+      if (!EFI_ERROR (gBS->CheckEvent (HttpIo->TimeoutEvent))) {
+        HttpIo->Http->Cancel (HttpIo->Http, &HttpIo->RspToken);
+        return EFI_TIMEOUT;
+      }
+
+      return EFI_SUCCESS;
+    }
+
+    gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+    HttpIo->IsRxDone = FALSE;
+
+    if (EFI_ERROR (HttpIo->RspToken.Status)) {
+      return HttpIo->RspToken.Status;
+    }
+
+    Message = HttpIo->RspToken.Message;
+    if (Connection->State == HttpBootRangeStateHeader) {
+      if (Message->Headers != NULL) {
+        HttpFreeHeaderFields (Message->Headers, Message->HeaderCount);
+        Message->Headers = NULL;
+      }
+
+      if (Connection->ResponseData.StatusCode != HTTP_STATUS_206_PARTIAL_CONTENT) {
+        return EFI_UNSUPPORTED;
+      }
+    } else {
+      Connection->Received += Message->BodyLength;
+    }
+
+    if (Connection->Received == Connection->End + 1 - Connection->Start) {
+      Connection->State = HttpBootRangeStateDone;
+      return EFI_SUCCESS;
+    }
+
+    return HttpBootRangeRecvResponse (Connection, FALSE, Buffer);
+
+  default:
+    return EFI_SUCCESS;
+  }
+}
+
+/**
+  Download the boot file into the caller's buffer through several HTTP connections,
+  each of which requests a byte range of the file. A failed range is requested again
+  from where it stopped on a new connection.
+
+  @param[in]       Private         The pointer to the driver's private data.
+  @param[in]       Url             The URL of the boot file.
+  @param[in]       FileSize        The size of the boot file.
+  @param[out]      Buffer          The memory buffer to transfer the file to.
+
+  @retval EFI_SUCCESS              The file was loaded.
+  @retval EFI_OUT_OF_RESOURCES     Could not allocate needed resources.
+  @retval EFI_UNSUPPORTED          The server didn't return the requested range.
+  @retval Others                   Unexpected error happened.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileByRange (
+  IN     HTTP_BOOT_PRIVATE_DATA   *Private,
+  IN     CHAR16                   *Url,
+  IN     UINTN                    FileSize,
+     OUT UINT8                    *Buffer
+  )
+{
+  EFI_STATUS                  Status;
+  HTTP_BOOT_RANGE_CONNECTION  *Connections;
+  HTTP_BOOT_RANGE_CONNECTION  *Connection;
+  CHAR8                       *HostName;
+  UINTN                       Count;
+  UINTN                       Index;
+  UINTN                       PartSize;
+  UINTN                       Done;
+
+  Count = MIN (PcdGet8 (PcdHttpBootRangeConnections), HTTP_BOOT_RANGE_MAX_CONNECTIONS);
+  ASSERT (Count > 1);
+
+  HostName = NULL;
+  Status = HttpUrlGetHostName (
+             Private->BootFileUri,
+             Private->BootFileUriParser,
+             &HostName
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Connections = AllocateZeroPool (Count * sizeof (HTTP_BOOT_RANGE_CONNECTION));
+  if (Connections == NULL) {
+    FreePool (HostName);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Split the file into Count ranges, the last one takes the remainder.
+  //
+  PartSize = FileSize / Count;
+  for (Index = 0; Index < Count; Index++) {
+    Connection = &Connections[Index];
+    Connection->Start              = Index * PartSize;
+    Connection->End                = (Index == Count - 1) ? FileSize - 1 : Connection->Start + PartSize - 1;
+    Connection->RequestData.Method = HttpMethodGet;
+    Connection->RequestData.Url    = Url;
+
+    Status = HttpBootInitHttpIo (Private, &Connection->HttpIo);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+    Connection->HttpCreated = TRUE;
+
+    Status = HttpBootRangeSendRequest (HostName, Connection);
+    if (EFI_ERROR (Status)) {
+      goto ON_EXIT;
+    }
+  }
+
+  //
+  // Drive all the connections until every range is received.
+  //
+  Done = 0;
+  while (Done < Count) {
+    for (Index = 0; Index < Count; Index++) {
+      Connection = &Connections[Index];
+      if (Connection->State == HttpBootRangeStateDone) {
+        continue;
+      }
+
+      Connection->HttpIo.Http->Poll (Connection->HttpIo.Http);
+
+      Status = HttpBootRangeProcess (Connection, Buffer);
+      if (!EFI_ERROR (Status)) {
+        if (Connection->State == HttpBootRangeStateDone) {
+          Done++;
+        }
+        continue;
+      }
+
+      if (Status == EFI_UNSUPPORTED || Connection->Retry >= HTTP_BOOT_RANGE_MAX_RETRY) {
+        goto ON_EXIT;
+      }
+
+      //
+      // Request the rest of the range again on a new connection.
+      //
+      DEBUG ((
+        EFI_D_WARN,
+        "HttpBootGetBootFileByRange: Range %d failed with %r at %Lu/%Lu bytes, retry.\n",
+        (UINT32) Index,
+        Status,
+        (UINT64) Connection->Received,
+        (UINT64) (Connection->End + 1 - Connection->Start)
+        ));
+      Connection->Retry++;
+      HttpIoDestroyIo (&Connection->HttpIo);
+      Connection->HttpCreated = FALSE;
+
+      Status = HttpBootInitHttpIo (Private, &Connection->HttpIo);
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+      Connection->HttpCreated = TRUE;
+
+      Status = HttpBootRangeSendRequest (HostName, Connection);
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+    }
+  }
+
+  Status = EFI_SUCCESS;
+
+ON_EXIT:
+  for (Index = 0; Index < Count; Index++) {
+    Connection = &Connections[Index];
+    if (Connection->HttpCreated) {
+      HttpIoDestroyIo (&Connection->HttpIo);
+    }
+    if (Connection->Header != NULL) {
+      HttpBootFreeHeader (Connection->Header);
+    }
+  }
+
+  //
+  // The cancelled tokens may have queued DPCs which reference the connections.
+  //
+  DispatchDpc ();
+
+  FreePool (Connections);
+  FreePool (HostName);
+  return Status;
+}
+
 /**
   This function download the boot file by using UEFI HTTP protocol.
   
@@ -776,6 +1163,7 @@ HttpBootGetBootFile (
   CHAR16                     *Url;
   BOOLEAN                    IdentityMode;
   UINTN                      ReceivedSize;
+  EFI_HTTP_HEADER            *Header;
   
   ASSERT (Private != NULL);
   ASSERT (Private->HttpCreated);
@@ -805,6 +1193,25 @@ HttpBootGetBootFile (
     }
   }
 
+  //
+  // Not found in cache. If the file is large and the server accepts byte ranges,
+  // try to download it through several HTTP connections in parallel.
+  //
+  if (!HeaderOnly && Private->AcceptRanges &&
+      (PcdGet8 (PcdHttpBootRangeConnections) > 1) &&
+      (Private->BootFileSize >= HTTP_BOOT_RANGE_MIN_SIZE) &&
+      (*BufferSize >= Private->BootFileSize)) {
+    Status = HttpBootGetBootFileByRange (Private, Url, Private->BootFileSize, Buffer);
+    if (!EFI_ERROR (Status)) {
+      *BufferSize = Private->BootFileSize;
+      *ImageType  = Private->ImageType;
+      FreePool (Url);
+      return EFI_SUCCESS;
+    }
+
+    DEBUG ((EFI_D_WARN, "HttpBootGetBootFile: Range download failed with %r, use a single connection.\n", Status));
+  }
+
   //
   // Not found in cache, try to download it through HTTP.
   //
@@ -959,6 +1366,12 @@ HttpBootGetBootFile (
     goto ERROR_5;
   }
 
+  //
+  // Record whether the server accepts byte ranges of the boot file.
+  //
+  Header = HttpFindHeader (ResponseData->HeaderCount, ResponseData->Headers, HTTP_HEADER_ACCEPT_RANGES);
+  Private->AcceptRanges = (BOOLEAN) ((Header != NULL) && (AsciiStriCmp (Header->FieldValue, "bytes") == 0));
+
   //
   // 3.2 Cache the response header.
   //
@@ -20,6 +20,13 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define HTTP_BOOT_RESPONSE_TIMEOUT           5000      // 5 seconds in uints of millisecond.
 #define HTTP_BOOT_BLOCK_SIZE                 1500
 
+//
+// Parallel range download of a large boot file, see PcdHttpBootRangeConnections.
+//
+#define HTTP_BOOT_RANGE_MIN_SIZE             SIZE_4MB  // Smaller files use a single connection.
+#define HTTP_BOOT_RANGE_MAX_CONNECTIONS      8
+#define HTTP_BOOT_RANGE_MAX_RETRY            3         // Retry count of each failed range.
+
 
 
 #define HTTP_USER_AGENT_EFI_HTTP_BOOT        "UefiHttpBoot/1.0"
@@ -46,6 +53,29 @@ typedef struct {
   LIST_ENTRY                 EntityDataList;  // Entity data (message-body)
 } HTTP_BOOT_CACHE_CONTENT;
 
+typedef enum {
+  HttpBootRangeStateRequest,
+  HttpBootRangeStateHeader,
+  HttpBootRangeStateBody,
+  HttpBootRangeStateDone
+} HTTP_BOOT_RANGE_STATE;
+
+//
+// One HTTP connection which downloads the byte range [Start, End] of the boot file.
+//
+typedef struct {
+  HTTP_IO                    HttpIo;
+  BOOLEAN                    HttpCreated;
+  HTTP_BOOT_RANGE_STATE      State;
+  UINTN                      Start;
+  UINTN                      End;
+  UINTN                      Received;        // Bytes of the range already in the buffer.
+  UINTN                      Retry;
+  HTTP_IO_HEADER             *Header;
+  EFI_HTTP_REQUEST_DATA      RequestData;
+  EFI_HTTP_RESPONSE_DATA     ResponseData;
+} HTTP_BOOT_RANGE_CONNECTION;
+
 //
 // Callback data for HTTP_BODY_PARSER_CALLBACK()
 //
@@ -192,6 +192,7 @@ struct _HTTP_BOOT_PRIVATE_DATA {
   CHAR8                                     *BootFileUri;
   VOID                                      *BootFileUriParser;
   UINTN                                     BootFileSize;
+  BOOLEAN                                   AcceptRanges;
   BOOLEAN                                   NoGateway;
   HTTP_BOOT_IMAGE_TYPE                      ImageType;
 
@@ -1731,6 +1731,69 @@ HttpTcpReceive (
   return HttpResponseWorker ((HTTP_TOKEN_WRAP *) Item->Value);
 }
 
+/**
+  Append a received fragment to the HTTP header buffer and check whether the end
+  of the HTTP headers has been received.
+
+  The buffer grows geometrically and is kept NULL terminated, and only the newly
+  appended data (plus the tail which may hold part of the end-of-header mark) is
+  searched, so a header block arriving in many fragments is neither copied nor
+  scanned again for every fragment.
+
+  @param[in, out]  HttpHeaders      The buffer holding the HTTP header message.
+  @param[in, out]  SizeofHeaders    The length of the data in HttpHeaders.
+  @param[in, out]  Capacity         The allocated size of HttpHeaders.
+  @param[in]       Fragment         The received fragment.
+  @param[out]      EndofHeader      The start of the end-of-header mark, or NULL.
+
+  @retval EFI_SUCCESS               The fragment is appended.
+  @retval EFI_OUT_OF_RESOURCES      Failed to grow the header buffer.
+
+**/
+EFI_STATUS
+HttpAppendHeaderFragment (
+  IN OUT CHAR8                **HttpHeaders,
+  IN OUT UINTN                *SizeofHeaders,
+  IN OUT UINTN                *Capacity,
+  IN     NET_FRAGMENT         *Fragment,
+     OUT CHAR8                **EndofHeader
+  )
+{
+  CHAR8                       *Buffer;
+  UINTN                       NewCapacity;
+  UINTN                       SearchStart;
+
+  if (*SizeofHeaders + Fragment->Len + 1 > *Capacity) {
+    NewCapacity = MAX (MAX (*Capacity * 2, DEF_BUF_LEN), *SizeofHeaders + Fragment->Len + 1);
+    Buffer      = AllocatePool (NewCapacity);
+    if (Buffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    if (*HttpHeaders != NULL) {
+      CopyMem (Buffer, *HttpHeaders, *SizeofHeaders);
+      FreePool (*HttpHeaders);
+    }
+
+    *HttpHeaders = Buffer;
+    *Capacity    = NewCapacity;
+  }
+
+  CopyMem (*HttpHeaders + *SizeofHeaders, Fragment->Bulk, Fragment->Len);
+
+  SearchStart = 0;
+  if (*SizeofHeaders > AsciiStrLen (HTTP_END_OF_HDR_STR)) {
+    SearchStart = *SizeofHeaders - AsciiStrLen (HTTP_END_OF_HDR_STR) + 1;
+  }
+
+  *SizeofHeaders += Fragment->Len;
+  (*HttpHeaders)[*SizeofHeaders] = '\0';
+
+  *EndofHeader = AsciiStrStr (*HttpHeaders + SearchStart, HTTP_END_OF_HDR_STR);
+
+  return EFI_SUCCESS;
+}
+
 /**
   Receive the HTTP header by processing the associated HTTP token.
 
@@ -1758,7 +1821,7 @@ HttpTcpReceiveHeader (
   EFI_TCP6_PROTOCOL             *Tcp6;
   CHAR8                         **EndofHeader;
   CHAR8                         **HttpHeaders;
-  CHAR8                         *Buffer;
+  UINTN                         Capacity;
   NET_FRAGMENT                  Fragment;
 
   ASSERT (HttpInstance != NULL);
@@ -1767,7 +1830,7 @@ HttpTcpReceiveHeader (
   HttpHeaders = HttpInstance->HttpHeaders;
   Tcp4 = HttpInstance->Tcp4;
   Tcp6 = HttpInstance->Tcp6;
-  Buffer      = NULL;
+  Capacity    = *SizeofHeaders;
   Rx4Token    = NULL;
   Rx6Token    = NULL;
   Fragment.Len  = 0;
@@ -1844,32 +1907,13 @@ HttpTcpReceiveHeader (
       }
 
       //
-      // Append the response string.
+      // Append the response string and check whether we received end of HTTP headers.
       //
-      *BufferSize = *SizeofHeaders + Fragment.Len;
-      Buffer      = AllocateZeroPool (*BufferSize);
-      if (Buffer == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
+      Status = HttpAppendHeaderFragment (HttpHeaders, SizeofHeaders, &Capacity, &Fragment, EndofHeader);
+      if (EFI_ERROR (Status)) {
         return Status;
       }
-
-      if (*HttpHeaders != NULL) {
-        CopyMem (Buffer, *HttpHeaders, *SizeofHeaders);
-        FreePool (*HttpHeaders);
-      }
-
-      CopyMem (
-        Buffer + *SizeofHeaders,
-        Fragment.Bulk,
-        Fragment.Len
-        );
-      *HttpHeaders   = Buffer;
-      *SizeofHeaders = *BufferSize;
-
-      //
-      // Check whether we received end of HTTP headers.
-      //
-      *EndofHeader = AsciiStrStr (*HttpHeaders, HTTP_END_OF_HDR_STR); 
+      *BufferSize = *SizeofHeaders;
     };
     
     //
@@ -1943,32 +1987,13 @@ HttpTcpReceiveHeader (
       }
 
       //
-      // Append the response string.
+      // Append the response string and check whether we received end of HTTP headers.
       //
-      *BufferSize = *SizeofHeaders + Fragment.Len;
-      Buffer      = AllocateZeroPool (*BufferSize);
-      if (Buffer == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
+      Status = HttpAppendHeaderFragment (HttpHeaders, SizeofHeaders, &Capacity, &Fragment, EndofHeader);
+      if (EFI_ERROR (Status)) {
         return Status;
       }
-
-      if (*HttpHeaders != NULL) {
-        CopyMem (Buffer, *HttpHeaders, *SizeofHeaders);
-        FreePool (*HttpHeaders);
-      }
-
-      CopyMem (
-        Buffer + *SizeofHeaders,
-        Fragment.Bulk,
-        Fragment.Len
-        );
-      *HttpHeaders   = Buffer;
-      *SizeofHeaders = *BufferSize;
-
-      //
-      // Check whether we received end of HTTP headers.
-      //
-      *EndofHeader = AsciiStrStr (*HttpHeaders, HTTP_END_OF_HDR_STR); 
+      *BufferSize = *SizeofHeaders;
     };
 
     //
@@ -541,6 +541,29 @@ HttpTcpReceive (
   IN VOID                   *Context
   );
 
+/**
+  Append a received fragment to the HTTP header buffer and check whether the end
+  of the HTTP headers has been received.
+
+  @param[in, out]  HttpHeaders     The buffer holding the HTTP header message.
+  @param[in, out]  SizeofHeaders   The length of the data in HttpHeaders.
+  @param[in, out]  Capacity        The allocated size of HttpHeaders.
+  @param[in]       Fragment        The received fragment.
+  @param[out]      EndofHeader     The start of the end-of-header mark, or NULL.
+
+  @retval EFI_SUCCESS              The fragment is appended.
+  @retval EFI_OUT_OF_RESOURCES     Failed to grow the header buffer.
+
+**/
+EFI_STATUS
+HttpAppendHeaderFragment (
+  IN OUT CHAR8                **HttpHeaders,
+  IN OUT UINTN                *SizeofHeaders,
+  IN OUT UINTN                *Capacity,
+  IN     NET_FRAGMENT         *Fragment,
+     OUT CHAR8                **EndofHeader
+  );
+
 /**
   Receive the HTTP header by processing the associated HTTP token.
 
@@ -3155,11 +3155,11 @@ IScsiSessionInit (
   Session->MaxConnections       = ISCSI_MAX_CONNS_PER_SESSION;
   Session->InitialR2T           = FALSE;
   Session->ImmediateData        = TRUE;
-  Session->MaxBurstLength       = 262144;
-  Session->FirstBurstLength     = MAX_RECV_DATA_SEG_LEN_IN_FFP;
+  Session->MaxBurstLength       = ISCSI_MAX_BURST_LENGTH;
+  Session->FirstBurstLength     = ISCSI_FIRST_BURST_LENGTH;
   Session->DefaultTime2Wait     = 2;
   Session->DefaultTime2Retain   = 20;
-  Session->MaxOutstandingR2T    = DEFAULT_MAX_OUTSTANDING_R2T;
+  Session->MaxOutstandingR2T    = ISCSI_MAX_OUTSTANDING_R2T;
   Session->DataPDUInOrder       = TRUE;
   Session->DataSequenceInOrder  = TRUE;
   Session->ErrorRecoveryLevel   = 0;
@@ -34,8 +34,18 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define ISCSI_MAX_CONNS_PER_SESSION             1
 
 #define DEFAULT_MAX_RECV_DATA_SEG_LEN           8192
-#define MAX_RECV_DATA_SEG_LEN_IN_FFP            65536
-#define DEFAULT_MAX_OUTSTANDING_R2T             1
+#define MAX_RECV_DATA_SEG_LEN_IN_FFP            262144
+
+//
+// Operational values proposed during login. The target may lower them. They
+// are large enough that bulk transfers are limited by the target rather than
+// the initiator. Writes up to FirstBurstLength go out as immediate or
+// unsolicited data without waiting for an R2T. Larger writes are split into
+// fewer R2T round trips, which the target may keep in flight.
+//
+#define ISCSI_MAX_BURST_LENGTH                  1048576
+#define ISCSI_FIRST_BURST_LENGTH                262144
+#define ISCSI_MAX_OUTSTANDING_R2T               4
 
 #define ISCSI_VERSION_MAX                       0x00
 #define ISCSI_VERSION_MIN                       0x00
@@ -46,6 +46,7 @@ typedef struct _MTFTP6_INSTANCE MTFTP6_INSTANCE;
 #define MTFTP6_GET_MAPPING_TIMEOUT     3
 #define MTFTP6_DEFAULT_MAX_RETRY       5
 #define MTFTP6_DEFAULT_BLK_SIZE        512
+#define MTFTP6_DEFAULT_WINDOW_SIZE     1
 #define MTFTP6_TICK_PER_SECOND         10000000U
 
 #define MTFTP6_SERVICE_FROM_THIS(a)    CR (a, MTFTP6_SERVICE, ServiceBinding, MTFTP6_SERVICE_SIGNATURE)
@@ -77,6 +78,16 @@ struct _MTFTP6_INSTANCE {
   UINT16                        LastBlk;
   LIST_ENTRY                    BlkList;
 
+  //
+  // Window of DATA blocks the server sends before it waits for an ACK
+  // (RFC 7440). WindowReceived counts the in-order blocks received since
+  // the last ACK. WindowRecovery is set once an ACK has been sent for a
+  // gap, so the rest of the broken window doesn't trigger more ACKs.
+  //
+  UINT16                        WindowSize;
+  UINT16                        WindowReceived;
+  BOOLEAN                       WindowRecovery;
+
   EFI_IPv6_ADDRESS              ServerIp;
   UINT16                        ServerCmdPort;
   UINT16                        ServerDataPort;
@@ -19,7 +19,8 @@ CHAR8 *mMtftp6SupportedOptions[MTFTP6_SUPPORTED_OPTIONS_NUM] = {
   "blksize",
   "timeout",
   "tsize",
-  "multicast"
+  "multicast",
+  "windowsize"
 };
 
 
@@ -228,6 +229,20 @@ Mtftp6ParseExtensionOption (
 
       ExtInfo->BitMap |= MTFTP6_OPT_MCAST_BIT;
 
+    } else if (AsciiStriCmp ((CHAR8 *) Opt->OptionStr, "windowsize") == 0) {
+      //
+      // windowsize option (RFC 7440). The protocol allows [1, 65535], but
+      // the number of blocks in flight is limited to [1, MTFTP6_MAX_WINDOW_SIZE].
+      //
+      Value = (UINT32) AsciiStrDecimalToUintn ((CHAR8 *) Opt->ValueStr);
+
+      if (Value < 1 || Value > MTFTP6_MAX_WINDOW_SIZE) {
+        return EFI_INVALID_PARAMETER;
+      }
+
+      ExtInfo->WindowSize = (UINT16) Value;
+      ExtInfo->BitMap    |= MTFTP6_OPT_WINDOWSIZE_BIT;
+
     } else if (IsRequest) {
       //
       // If it's a request, unsupported; else if it's a reply, ignore.
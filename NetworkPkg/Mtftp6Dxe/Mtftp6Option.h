@@ -26,7 +26,7 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
 
-#define MTFTP6_SUPPORTED_OPTIONS_NUM  4
+#define MTFTP6_SUPPORTED_OPTIONS_NUM  5
 #define MTFTP6_OPCODE_LEN             2
 #define MTFTP6_ERRCODE_LEN            2
 #define MTFTP6_BLKNO_LEN              2
@@ -39,6 +39,9 @@
 #define MTFTP6_OPT_TIMEOUT_BIT        0x02
 #define MTFTP6_OPT_TSIZE_BIT          0x04
 #define MTFTP6_OPT_MCAST_BIT          0x08
+#define MTFTP6_OPT_WINDOWSIZE_BIT     0x10
+
+#define MTFTP6_MAX_WINDOW_SIZE        64
 
 extern CHAR8 *mMtftp6SupportedOptions[MTFTP6_SUPPORTED_OPTIONS_NUM];
 
@@ -49,6 +52,7 @@ typedef struct {
   EFI_IPv6_ADDRESS          McastIp;
   UINT16                    McastPort;
   BOOLEAN                   IsMaster;
+  UINT16                    WindowSize;
   UINT32                    BitMap;
 } MTFTP6_EXT_OPTION_INFO;
 
@@ -60,6 +60,7 @@ Mtftp6RrqSendAck (
   //
   Instance->CurRetry = 0;
   Instance->LastPacket = Packet;
+  Instance->WindowReceived = 0;
 
   return Mtftp6TransmitPacket (Instance, Packet);
 }
@@ -234,7 +235,15 @@ Mtftp6RrqHandleData (
   // the last ACK then restart receiving. If we are passive, save
   // the block.
   //
+  // With a window larger than one, ACK the last in-order block so the
+  // server restarts the window from the gap. The remaining blocks of the
+  // broken window are dropped without further ACKs.
+  //
   if (Instance->IsMaster && (Expected != BlockNum)) {
+    if (Instance->WindowSize > 1 && Instance->WindowRecovery) {
+      return EFI_SUCCESS;
+    }
+
     //
     // Free the received packet before send new packet in ReceiveNotify,
     // since the udpio might need to be reconfigured.
@@ -242,6 +251,11 @@ Mtftp6RrqHandleData (
     NetbufFree (*UdpPacket);
     *UdpPacket = NULL;
 
+    if (Instance->WindowSize > 1) {
+      Instance->WindowRecovery = TRUE;
+      return Mtftp6RrqSendAck (Instance, (UINT16) (Expected - 1));
+    }
+
     Mtftp6TransmitPacket (Instance, Instance->LastPacket);
     return EFI_SUCCESS;
   }
@@ -252,11 +266,17 @@ Mtftp6RrqHandleData (
     return Status;
   }
 
+  Instance->WindowRecovery = FALSE;
+  Instance->WindowReceived++;
+
   //
   // Reset the passive client's timer whenever it received a valid data packet.
+  // The active client resets it too when it doesn't ACK every block.
   //
   if (!Instance->IsMaster) {
     Instance->PacketToLive = Instance->Timeout * 2;
+  } else if (Instance->WindowSize > 1) {
+    Instance->PacketToLive = Instance->Timeout;
   }
 
   //
@@ -279,6 +299,13 @@ Mtftp6RrqHandleData (
       *IsCompleted = TRUE;
 
     } else {
+      //
+      // Only ACK the last block of each window.
+      //
+      if (Instance->WindowReceived < Instance->WindowSize) {
+        return EFI_SUCCESS;
+      }
+
       BlockNum     = (UINT16) (Expected - 1);
     }
     //
@@ -335,6 +362,13 @@ Mtftp6RrqOackValid (
     return FALSE;
   }
 
+  //
+  // Server can only specify a smaller window size to be used.
+  //
+  if (((ReplyInfo->BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) && (ReplyInfo->WindowSize > RequestInfo->WindowSize)) {
+    return FALSE;
+  }
+
   //
   // The server can send ",,master" to client to change its master
   // setting. But if it use the specific multicast channel, it can't
@@ -628,6 +662,13 @@ Mtftp6RrqHandleOack (
     if (ExtInfo.Timeout != 0) {
       Instance->Timeout = ExtInfo.Timeout;
     }
+
+    //
+    // The window only applies to unicast download.
+    //
+    if (ExtInfo.WindowSize != 0) {
+      Instance->WindowSize = ExtInfo.WindowSize;
+    }
   }
 
   //
@@ -182,6 +182,11 @@ SockTcpDataToRcv (
 /**
   Copy data from socket buffer to an application provided receive buffer.
 
+  The receive queue holds the NET_BUFs handed up by the IP layer, which still
+  reference the MNP receive blocks. Walk the queue once and copy straight into
+  the application fragments, rather than seeking the offset from the head of
+  the queue again for every fragment.
+
   @param[in]  Sock        Pointer to the socket.
   @param[in]  TcpRxData   Pointer to the application provided receive buffer.
   @param[in]  RcvdBytes   The maximum length of the data can be copied.
@@ -198,19 +203,24 @@ SockSetTcpRxData (
 {
   UINT32                  Index;
   UINT32                  CopyBytes;
-  UINT32                  OffSet;
+  UINT32                  Left;
+  UINT32                  Len;
+  UINT32                  NbufOffset;
+  UINT8                   *Dest;
+  NET_BUF                 *Nbuf;
   EFI_TCP4_RECEIVE_DATA   *RxData;
   EFI_TCP4_FRAGMENT_DATA  *Fragment;
 
   RxData  = (EFI_TCP4_RECEIVE_DATA *) TcpRxData;
 
-  OffSet  = 0;
-
   ASSERT (RxData->DataLength >= RcvdBytes);
 
   RxData->DataLength  = RcvdBytes;
   RxData->UrgentFlag  = IsUrg;
 
+  Nbuf        = SockBufFirst (&Sock->RcvBuffer);
+  NbufOffset  = 0;
+
   //
   // Copy the CopyBytes data from socket receive buffer to RxData.
   //
@@ -218,17 +228,28 @@ SockSetTcpRxData (
 
     Fragment  = &RxData->FragmentTable[Index];
     CopyBytes = MIN ((UINT32) (Fragment->FragmentLength), RcvdBytes);
+    Dest      = (UINT8 *) Fragment->FragmentBuffer;
+    Left      = CopyBytes;
+
+    while ((Left > 0) && (Nbuf != NULL)) {
+      if (NbufOffset == Nbuf->TotalSize) {
+        Nbuf        = SockBufNext (&Sock->RcvBuffer, Nbuf);
+        NbufOffset  = 0;
+        continue;
+      }
 
-    NetbufQueCopy (
-      Sock->RcvBuffer.DataQueue,
-      OffSet,
-      CopyBytes,
-      Fragment->FragmentBuffer
-      );
+      Len = MIN (Left, Nbuf->TotalSize - NbufOffset);
+      NetbufCopy (Nbuf, NbufOffset, Len, Dest);
+
+      Dest       += Len;
+      Left       -= Len;
+      NbufOffset += Len;
+    }
+
+    ASSERT (Left == 0);
 
     Fragment->FragmentLength = CopyBytes;
     RcvdBytes -= CopyBytes;
-    OffSet += CopyBytes;
   }
 }
 
@@ -92,6 +92,10 @@ TlsCleanService (
   )
 {
   if (Service != NULL) {
+    if (Service->TlsSession != NULL) {
+      TlsFreeSession (Service->TlsSession);
+    }
+
     if (Service->TlsCtx != NULL) {
       TlsCtxFree (Service->TlsCtx);
     }
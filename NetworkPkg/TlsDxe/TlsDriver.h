@@ -62,6 +62,13 @@ struct _TLS_SERVICE {
   // created for the connections.
   //
   VOID                            *TlsCtx;
+
+  //
+  // Session of the most recent client connection whose server was verified
+  // against the CA store. It is offered to new client connections so that
+  // reconnecting to the same server can use an abbreviated handshake.
+  //
+  VOID                            *TlsSession;
 };
 
 struct _TLS_INSTANCE {
@@ -410,6 +410,7 @@ TlsBuildResponsePacket (
   EFI_STATUS                Status;
   TLS_INSTANCE              *Instance;
   EFI_TPL                   OldTpl;
+  VOID                      *Session;
 
   Status = EFI_SUCCESS;
 
@@ -427,6 +428,15 @@ TlsBuildResponsePacket (
   if(RequestBuffer == NULL && RequestSize == 0) {
     switch (Instance->TlsSessionState) {
     case EfiTlsSessionNotStarted:
+      //
+      // Offer the cached session for resumption. The server falls back to
+      // a full handshake if it no longer knows it.
+      //
+      if (Instance->Service->TlsSession != NULL &&
+          TlsGetConnectionEnd (Instance->TlsConn) == EfiTlsClient) {
+        TlsSetSession (Instance->TlsConn, Instance->Service->TlsSession);
+      }
+
       //
       // ClientHello.
       //
@@ -518,6 +528,22 @@ TlsBuildResponsePacket (
 
       if (!TlsInHandshake (Instance->TlsConn)) {
         Instance->TlsSessionState = EfiTlsSessionDataTransferring;
+
+        //
+        // Keep the session for later connections. Only sessions whose server
+        // certificate chain was verified are cached, since a resumed handshake
+        // does not verify it again.
+        //
+        if (TlsGetConnectionEnd (Instance->TlsConn) == EfiTlsClient &&
+            (TlsGetVerify (Instance->TlsConn) & EFI_TLS_VERIFY_PEER) != 0) {
+          Session = TlsGetSession (Instance->TlsConn);
+          if (Session != NULL) {
+            if (Instance->Service->TlsSession != NULL) {
+              TlsFreeSession (Instance->Service->TlsSession);
+            }
+            Instance->Service->TlsSession = Session;
+          }
+        }
       }
     } else {
       //
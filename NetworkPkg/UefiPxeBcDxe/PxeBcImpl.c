@@ -225,6 +225,11 @@ EfiPxeBcStart (
     Private->BlockSize   = (UINTN) PcdGet64 (PcdTftpBlockSize);
   }
 
+  //
+  // Request the TFTP windowsize option for downloads if it's enabled.
+  //
+  Private->WindowSize = (UINTN) MIN (PcdGet8 (PcdPxeTftpWindowSize), PXE_MTFTP_MAX_WINDOW_SIZE);
+
   //
   // Create event for UdpRead/UdpWrite timeout since they are both blocking API.
   //
@@ -19,7 +19,8 @@ CHAR8 *mMtftpOptions[PXE_MTFTP_OPTION_MAXIMUM_INDEX] = {
   "blksize",
   "timeout",
   "tsize",
-  "multicast"
+  "multicast",
+  "windowsize"
 };
 
 
@@ -257,14 +258,16 @@ PxeBcMtftp6ReadFile (
 {
   EFI_MTFTP6_PROTOCOL                 *Mtftp6;
   EFI_MTFTP6_TOKEN                    Token;
-  EFI_MTFTP6_OPTION                   ReqOpt[1];
+  EFI_MTFTP6_OPTION                   ReqOpt[2];
   UINT32                              OptCnt;
   UINT8                               OptBuf[128];
+  UINTN                               OptBufLen;
   EFI_STATUS                          Status;
 
   Status                    = EFI_DEVICE_ERROR;
   Mtftp6                    = Private->Mtftp6;
   OptCnt                    = 0;
+  OptBufLen                 = 0;
   Config->InitialServerPort = PXEBC_BS_DOWNLOAD_PORT;
 
   Status = Mtftp6->Configure (Mtftp6, Config);
@@ -276,6 +279,14 @@ PxeBcMtftp6ReadFile (
     ReqOpt[0].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_BLKSIZE_INDEX];
     ReqOpt[0].ValueStr  = OptBuf;
     PxeBcUintnToAscDec (*BlockSize, ReqOpt[0].ValueStr, PXE_MTFTP_OPTBUF_MAXNUM_INDEX);
+    OptBufLen = AsciiStrLen ((CHAR8 *) ReqOpt[0].ValueStr) + 1;
+    OptCnt++;
+  }
+
+  if (Private->WindowSize > 1) {
+    ReqOpt[OptCnt].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_WINDOWSIZE_INDEX];
+    ReqOpt[OptCnt].ValueStr  = OptBuf + OptBufLen;
+    PxeBcUintnToAscDec (Private->WindowSize, ReqOpt[OptCnt].ValueStr, PXE_MTFTP_OPTBUF_MAXNUM_INDEX - OptBufLen);
     OptCnt++;
   }
 
@@ -415,14 +426,16 @@ PxeBcMtftp6ReadDirectory (
 {
   EFI_MTFTP6_PROTOCOL                  *Mtftp6;
   EFI_MTFTP6_TOKEN                     Token;
-  EFI_MTFTP6_OPTION                    ReqOpt[1];
+  EFI_MTFTP6_OPTION                    ReqOpt[2];
   UINT32                               OptCnt;
   UINT8                                OptBuf[128];
+  UINTN                                OptBufLen;
   EFI_STATUS                           Status;
 
   Status                    = EFI_DEVICE_ERROR;
   Mtftp6                    = Private->Mtftp6;
   OptCnt                    = 0;
+  OptBufLen                 = 0;
   Config->InitialServerPort = PXEBC_BS_DOWNLOAD_PORT;
 
   Status = Mtftp6->Configure (Mtftp6, Config);
@@ -434,6 +447,14 @@ PxeBcMtftp6ReadDirectory (
     ReqOpt[0].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_BLKSIZE_INDEX];
     ReqOpt[0].ValueStr  = OptBuf;
     PxeBcUintnToAscDec (*BlockSize, ReqOpt[0].ValueStr, PXE_MTFTP_OPTBUF_MAXNUM_INDEX);
+    OptBufLen = AsciiStrLen ((CHAR8 *) ReqOpt[0].ValueStr) + 1;
+    OptCnt++;
+  }
+
+  if (Private->WindowSize > 1) {
+    ReqOpt[OptCnt].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_WINDOWSIZE_INDEX];
+    ReqOpt[OptCnt].ValueStr  = OptBuf + OptBufLen;
+    PxeBcUintnToAscDec (Private->WindowSize, ReqOpt[OptCnt].ValueStr, PXE_MTFTP_OPTBUF_MAXNUM_INDEX - OptBufLen);
     OptCnt++;
   }
 
@@ -703,14 +724,16 @@ PxeBcMtftp4ReadFile (
 {
   EFI_MTFTP4_PROTOCOL *Mtftp4;
   EFI_MTFTP4_TOKEN    Token;
-  EFI_MTFTP4_OPTION   ReqOpt[1];
+  EFI_MTFTP4_OPTION   ReqOpt[2];
   UINT32              OptCnt;
   UINT8               OptBuf[128];
+  UINTN               OptBufLen;
   EFI_STATUS          Status;
 
   Status                    = EFI_DEVICE_ERROR;
   Mtftp4                    = Private->Mtftp4;
   OptCnt                    = 0;
+  OptBufLen                 = 0;
   Config->InitialServerPort = PXEBC_BS_DOWNLOAD_PORT;
 
   Status = Mtftp4->Configure (Mtftp4, Config);
@@ -722,6 +745,14 @@ PxeBcMtftp4ReadFile (
     ReqOpt[0].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_BLKSIZE_INDEX];
     ReqOpt[0].ValueStr  = OptBuf;
     PxeBcUintnToAscDec (*BlockSize, ReqOpt[0].ValueStr, PXE_MTFTP_OPTBUF_MAXNUM_INDEX);
+    OptBufLen = AsciiStrLen ((CHAR8 *) ReqOpt[0].ValueStr) + 1;
+    OptCnt++;
+  }
+
+  if (Private->WindowSize > 1) {
+    ReqOpt[OptCnt].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_WINDOWSIZE_INDEX];
+    ReqOpt[OptCnt].ValueStr  = OptBuf + OptBufLen;
+    PxeBcUintnToAscDec (Private->WindowSize, ReqOpt[OptCnt].ValueStr, PXE_MTFTP_OPTBUF_MAXNUM_INDEX - OptBufLen);
     OptCnt++;
   }
 
@@ -861,14 +892,16 @@ PxeBcMtftp4ReadDirectory (
 {
   EFI_MTFTP4_PROTOCOL *Mtftp4;
   EFI_MTFTP4_TOKEN    Token;
-  EFI_MTFTP4_OPTION   ReqOpt[1];
+  EFI_MTFTP4_OPTION   ReqOpt[2];
   UINT32              OptCnt;
   UINT8               OptBuf[128];
+  UINTN               OptBufLen;
   EFI_STATUS          Status;
 
   Status                    = EFI_DEVICE_ERROR;
   Mtftp4                    = Private->Mtftp4;
   OptCnt                    = 0;
+  OptBufLen                 = 0;
   Config->InitialServerPort = PXEBC_BS_DOWNLOAD_PORT;
 
   Status = Mtftp4->Configure (Mtftp4, Config);
@@ -880,6 +913,14 @@ PxeBcMtftp4ReadDirectory (
     ReqOpt[0].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_BLKSIZE_INDEX];
     ReqOpt[0].ValueStr  = OptBuf;
     PxeBcUintnToAscDec (*BlockSize, ReqOpt[0].ValueStr, PXE_MTFTP_OPTBUF_MAXNUM_INDEX);
+    OptBufLen = AsciiStrLen ((CHAR8 *) ReqOpt[0].ValueStr) + 1;
+    OptCnt++;
+  }
+
+  if (Private->WindowSize > 1) {
+    ReqOpt[OptCnt].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_WINDOWSIZE_INDEX];
+    ReqOpt[OptCnt].ValueStr  = OptBuf + OptBufLen;
+    PxeBcUintnToAscDec (Private->WindowSize, ReqOpt[OptCnt].ValueStr, PXE_MTFTP_OPTBUF_MAXNUM_INDEX - OptBufLen);
     OptCnt++;
   }
 
@@ -137,6 +137,12 @@ VirtioNetGetStatus (
       ASSERT (Dev->TxCurPending <= Dev->TxMaxPending);
 
       UsedElemIdx = Dev->TxLastUsed++ % Dev->TxRing.QueueSize;
+      if (Dev->EventIdx) {
+        //
+        // see the same in VirtioNetReceive()
+        //
+        *Dev->TxRing.Avail.UsedEvent = (UINT16) (Dev->TxLastUsed - 1);
+      }
       DescIdx = Dev->TxRing.Used.UsedElem[UsedElemIdx].Id;
       ASSERT (DescIdx < (UINT32) (2 * Dev->TxMaxPending - 1));
 
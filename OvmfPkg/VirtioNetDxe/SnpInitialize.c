@@ -197,11 +197,15 @@ VirtioNetInitTx (
   MemoryFence ();
   Dev->TxLastUsed = *Dev->TxRing.Used.Idx;
   ASSERT (Dev->TxLastUsed == 0);
+  Dev->TxLastAvail = *Dev->TxRing.Avail.Idx;
 
   //
-  // want no interrupt when a transmit completes
+  // want no interrupt when a transmit completes; with VIRTIO_F_RING_EVENT_IDX,
+  // the device ignores the flag and we have to park used_event behind
+  // TxLastUsed instead
   //
   *Dev->TxRing.Avail.Flags = (UINT16) VRING_AVAIL_F_NO_INTERRUPT;
+  *Dev->TxRing.Avail.UsedEvent = (UINT16) (Dev->TxLastUsed - 1);
 
   return EFI_SUCCESS;
 }
@@ -282,9 +286,11 @@ VirtioNetInitRx (
   //
   // virtio-0.9.5, 2.4.2 Receiving Used Buffers From the Device:
   // the host should not send interrupts, we'll poll in VirtioNetReceive()
-  // and VirtioNetIsPacketAvailable().
+  // and VirtioNetIsPacketAvailable(). The used_event index takes the place of
+  // the flag if VIRTIO_F_RING_EVENT_IDX has been negotiated.
   //
   *Dev->RxRing.Avail.Flags = (UINT16) VRING_AVAIL_F_NO_INTERRUPT;
+  *Dev->RxRing.Avail.UsedEvent = (UINT16) (Dev->RxLastUsed - 1);
 
   //
   // now set up a separate, two-part descriptor chain for each RX packet, and
@@ -319,6 +325,7 @@ VirtioNetInitRx (
   //
   MemoryFence ();
   *Dev->RxRing.Avail.Idx = RxAlwaysPending;
+  Dev->RxLastAvail = RxAlwaysPending;
 
   //
   // At this point reception may already be running. In order to make it sure,
@@ -439,7 +446,9 @@ VirtioNetInitialize (
   ASSERT (Dev->Snm.MediaPresentSupported ==
     !!(Features & VIRTIO_NET_F_STATUS));
 
-  Features &= VIRTIO_NET_F_MAC | VIRTIO_NET_F_STATUS | VIRTIO_F_VERSION_1;
+  Features &= VIRTIO_NET_F_MAC | VIRTIO_NET_F_STATUS | VIRTIO_F_VERSION_1 |
+              VIRTIO_F_RING_EVENT_IDX;
+  Dev->EventIdx = (BOOLEAN) ((Features & VIRTIO_F_RING_EVENT_IDX) != 0);
 
   //
   // In virtio-1.0, feature negotiation is expected to complete before queue
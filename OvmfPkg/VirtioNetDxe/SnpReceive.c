@@ -165,6 +165,13 @@ VirtioNetReceive (
 
 RecycleDesc:
   ++Dev->RxLastUsed;
+  if (Dev->EventIdx) {
+    //
+    // Keep the used_event index behind the entries we've consumed, so that
+    // the device never finds a reason to interrupt us.
+    //
+    *Dev->RxRing.Avail.UsedEvent = (UINT16) (Dev->RxLastUsed - 1);
+  }
 
   //
   // virtio-0.9.5, 2.4.1 Supplying Buffers to The Device
@@ -176,10 +183,22 @@ RecycleDesc:
   MemoryFence ();
   *Dev->RxRing.Avail.Idx = AvailIdx;
 
-  MemoryFence ();
-  NotifyStatus = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_RX);
-  if (!EFI_ERROR (Status)) { // earlier error takes precedence
-    Status = NotifyStatus;
+  //
+  // Defer the notification until we've drained the used entries seen above;
+  // the recycled descriptors are then reported to the device in one batch. The
+  // device can't starve meanwhile, as it only runs out of buffers after having
+  // filled (and returned) all of them.
+  //
+  if (Dev->RxLastUsed == RxCurUsed) {
+    NotifyStatus = VirtioNetNotifyQueue (
+                     Dev,
+                     VIRTIO_NET_Q_RX,
+                     &Dev->RxRing,
+                     &Dev->RxLastAvail
+                     );
+    if (!EFI_ERROR (Status)) { // earlier error takes precedence
+      Status = NotifyStatus;
+    }
   }
 
 Exit:
@@ -14,6 +14,7 @@
 
 **/
 
+#include <Library/BaseLib.h>
 #include <Library/MemoryAllocationLib.h>
 
 #include "VirtioNet.h"
@@ -51,3 +52,70 @@ VirtioNetShutdownTx (
 {
   FreePool (Dev->TxFreeStack);
 }
+
+
+/**
+  Notify the device about buffers that have been added to the available ring
+  of a virtqueue since the last call, unless the device has indicated that it
+  does not need the notification.
+
+  With VIRTIO_F_RING_EVENT_IDX negotiated, the device publishes the available
+  index at which it wants to be notified in the "avail_event" field of the used
+  ring (virtio-1.0, 2.4.7.2 Notification Suppression). Otherwise the device
+  sets VRING_USED_F_NO_NOTIFY in the used ring's flags while it is processing
+  the queue anyway (virtio-0.9.5, 2.4.1.4 Notifying the Device).
+
+  Either way, the notification is only an optimization hint on the device's
+  side; skipping it when permitted saves a VM exit per buffer.
+
+  @param[in,out] Dev        The VNET_DEV driver instance.
+
+  @param[in]     Index      VIRTIO_NET_Q_RX or VIRTIO_NET_Q_TX.
+
+  @param[in]     Ring       The virtio ring that belongs to Index.
+
+  @param[in,out] LastAvail  On input, the available index that the previous
+                            call for this virtqueue has seen. On output, the
+                            current available index.
+
+  @retval EFI_SUCCESS  The device didn't need a notification.
+  @return              Status codes from VIRTIO_DEVICE_PROTOCOL.SetQueueNotify.
+**/
+EFI_STATUS
+EFIAPI
+VirtioNetNotifyQueue (
+  IN OUT VNET_DEV *Dev,
+  IN     UINT16   Index,
+  IN     VRING    *Ring,
+  IN OUT UINT16   *LastAvail
+  )
+{
+  UINT16  NewAvail;
+  UINT16  OldAvail;
+  BOOLEAN Notify;
+
+  //
+  // The updated available index must be visible to the device before we look
+  // at its suppression hints, or else we could miss a needed notification.
+  //
+  MemoryFence ();
+  NewAvail = *Ring->Avail.Idx;
+  OldAvail = *LastAvail;
+  *LastAvail = NewAvail;
+
+  if (Dev->EventIdx) {
+    //
+    // vring_need_event(): notify if the device's avail_event lies in
+    // [OldAvail, NewAvail), modulo 2^16
+    //
+    Notify = (BOOLEAN) ((UINT16) (NewAvail - *Ring->Used.AvailEvent - 1) <
+                        (UINT16) (NewAvail - OldAvail));
+  } else {
+    Notify = (BOOLEAN) ((*Ring->Used.Flags & VRING_USED_F_NO_NOTIFY) == 0);
+  }
+
+  if (!Notify) {
+    return EFI_SUCCESS;
+  }
+  return Dev->VirtIo->SetQueueNotify (Dev->VirtIo, Index);
+}
@@ -160,8 +160,12 @@ VirtioNetTransmit (
   MemoryFence ();
   *Dev->TxRing.Avail.Idx = AvailIdx;
 
-  MemoryFence ();
-  Status = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_TX);
+  Status = VirtioNetNotifyQueue (
+             Dev,
+             VIRTIO_NET_Q_TX,
+             &Dev->TxRing,
+             &Dev->TxLastAvail
+             );
 
 Exit:
   gBS->RestoreTPL (OldTpl);
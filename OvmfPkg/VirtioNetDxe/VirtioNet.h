@@ -80,10 +80,12 @@ typedef struct {
   EFI_EVENT                   ExitBoot;          // VirtioNetSnpPopulate
   EFI_DEVICE_PATH_PROTOCOL    *MacDevicePath;    // VirtioNetDriverBindingStart
   EFI_HANDLE                  MacHandle;         // VirtioNetDriverBindingStart
+  BOOLEAN                     EventIdx;          // VirtioNetInitialize
 
   VRING                       RxRing;            // VirtioNetInitRing
   UINT8                       *RxBuf;            // VirtioNetInitRx
   UINT16                      RxLastUsed;        // VirtioNetInitRx
+  UINT16                      RxLastAvail;       // VirtioNetInitRx
 
   VRING                       TxRing;            // VirtioNetInitRing
   UINT16                      TxMaxPending;      // VirtioNetInitTx
@@ -91,6 +93,7 @@ typedef struct {
   UINT16                      *TxFreeStack;      // VirtioNetInitTx
   VIRTIO_1_0_NET_REQ          TxSharedReq;       // VirtioNetInitTx
   UINT16                      TxLastUsed;        // VirtioNetInitTx
+  UINT16                      TxLastAvail;       // VirtioNetInitTx
 } VNET_DEV;
 
 
@@ -263,6 +266,15 @@ VirtioNetShutdownTx (
   IN OUT VNET_DEV *Dev
   );
 
+EFI_STATUS
+EFIAPI
+VirtioNetNotifyQueue (
+  IN OUT VNET_DEV *Dev,
+  IN     UINT16   Index,
+  IN     VRING    *Ring,
+  IN OUT UINT16   *LastAvail
+  );
+
 //
 // event callbacks
 //